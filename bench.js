@@ -0,0 +1,269 @@
+/*
+ * bench.js
+ *
+ * Copyright (c) 2024-2025 Xiongfei Shi
+ *
+ * Author: Xiongfei Shi <xiongfei.shi(a)icloud.com>
+ * License: Apache-2.0
+ *
+ * https://github.com/shixiongfei/napi-talib
+ */
+
+import fs from "node:fs";
+import os from "node:os";
+import talib from "./index.js";
+
+/*
+ * node bench.js [options]
+ *
+ *   --sizes 100,1000      Input lengths, defaults to 1e2..1e7
+ *   --functions SMA,RSI   Functions to run, defaults to getFunctions()
+ *   --modes sync,async    Call modes, defaults to both
+ *   --outputs array,typed Plain arrays in and out, or Float64Array in and
+ *                         typed results out, defaults to both
+ *   --time 200            Milliseconds spent on each case, at least one run
+ *   --output file.json    Write the report to a file instead of stdout
+ *   --compare base.json [current.json] [--threshold 10]
+ *                         Compare with a previous report, running the
+ *                         benchmark unless a second report is given. Exits
+ *                         with 1 when a case got slower than the threshold.
+ *
+ * Times are medians in microseconds. parse, compute and marshal are measured
+ * natively around reading the inputs, TA-Lib and building the result.
+ */
+
+const parseArgs = (argv) => {
+  const args = {
+    sizes: [1e2, 1e3, 1e4, 1e5, 1e6, 1e7],
+    functions: null,
+    modes: ["sync", "async"],
+    outputs: ["array", "typed"],
+    time: 200,
+    output: null,
+    compare: null,
+    threshold: 10,
+  };
+  const list = (value) => value.split(",").filter((item) => item.length > 0);
+
+  for (let i = 0; i < argv.length; ++i) {
+    switch (argv[i]) {
+      case "--sizes":
+        args.sizes = list(argv[++i]).map(Number);
+        break;
+      case "--functions":
+        args.functions = list(argv[++i]);
+        break;
+      case "--modes":
+        args.modes = list(argv[++i]);
+        break;
+      case "--outputs":
+        args.outputs = list(argv[++i]);
+        break;
+      case "--time":
+        args.time = Number(argv[++i]);
+        break;
+      case "--output":
+        args.output = argv[++i];
+        break;
+      case "--threshold":
+        args.threshold = Number(argv[++i]);
+        break;
+      case "--compare":
+        args.compare = [argv[++i]];
+
+        if (i + 1 < argv.length && !argv[i + 1].startsWith("--"))
+          args.compare.push(argv[++i]);
+        break;
+      default:
+        throw new Error(`Unknown option '${argv[i]}'`);
+    }
+  }
+
+  return args;
+};
+
+/* Random walk bars, the same for every run */
+const createSeries = (size) => {
+  const open = new Float64Array(size);
+  const high = new Float64Array(size);
+  const low = new Float64Array(size);
+  const close = new Float64Array(size);
+  const volume = new Float64Array(size);
+  const periods = new Int32Array(size);
+  let seed = 1;
+  let price = 100;
+
+  const random = () => {
+    seed = (seed * 16807) % 2147483647;
+    return seed / 2147483647;
+  };
+
+  for (let i = 0; i < size; ++i) {
+    open[i] = price;
+    price = Math.max(1, price + (random() - 0.5) * 2);
+    close[i] = price;
+    high[i] = Math.max(open[i], close[i]) + random();
+    low[i] = Math.min(open[i], close[i]) - random();
+    volume[i] = 1000 + Math.floor(random() * 10000);
+    periods[i] = 2 + Math.floor(random() * 29);
+  }
+
+  return { open, high, low, close, volume, openInterest: volume, periods };
+};
+
+const createInputs = (funcInfo, series, output) => {
+  const params = {};
+  const reals = [series.close, series.open, series.high];
+  let realIdx = 0;
+
+  const wrap = (array) => (output === "typed" ? array : Array.from(array));
+
+  for (const input of funcInfo.inputs) {
+    if (input.type === "price") {
+      for (const flag of input.flags) params[flag] = wrap(series[flag]);
+    } else if (input.type === "integer") {
+      params[input.name] = wrap(series.periods);
+    } else {
+      params[input.name] = wrap(reals[realIdx++ % reals.length]);
+    }
+  }
+
+  return params;
+};
+
+const median = (values) => {
+  const sorted = [...values].sort((a, b) => a - b);
+  const middle = sorted.length >> 1;
+
+  return sorted.length % 2
+    ? sorted[middle]
+    : (sorted[middle - 1] + sorted[middle]) / 2;
+};
+
+const runOnce = (param, mode) => {
+  const startedAt = process.hrtime.bigint();
+  const finish = (result) => ({
+    total: Number(process.hrtime.bigint() - startedAt) / 1000,
+    ...result.timings,
+  });
+
+  if (mode === "sync") return Promise.resolve(finish(talib.execute(param)));
+
+  return new Promise((resolve, reject) => {
+    talib.execute(param, (error, result) =>
+      error ? reject(error) : resolve(finish(result))
+    );
+  });
+};
+
+const runCase = async (name, size, mode, output, series, time) => {
+  const report = { name, size, mode, output };
+  const samples = { parse: [], compute: [], marshal: [], total: [] };
+  const param = {
+    name,
+    startIdx: 0,
+    endIdx: size - 1,
+    params: createInputs(talib.explain(name), series, output),
+    typed: output === "typed",
+    profile: true,
+  };
+  let deadline;
+
+  try {
+    /* Warm up, the first call also resolves the function handle */
+    await runOnce(param, mode);
+    deadline = performance.now() + time;
+
+    do {
+      const timings = await runOnce(param, mode);
+
+      for (const key in samples) samples[key].push(timings[key]);
+    } while (performance.now() < deadline);
+  } catch (error) {
+    return { ...report, error: error.message };
+  }
+
+  report.iterations = samples.total.length;
+
+  for (const key in samples) report[key] = median(samples[key]);
+
+  return report;
+};
+
+const runBenchmark = async (args) => {
+  const functions = args.functions ?? talib.getFunctions();
+  const results = [];
+
+  for (const size of args.sizes) {
+    const series = createSeries(size);
+
+    for (const name of functions)
+      for (const mode of args.modes)
+        for (const output of args.outputs)
+          results.push(
+            await runCase(name, size, mode, output, series, args.time)
+          );
+  }
+
+  return {
+    version: talib.version(),
+    simd: talib.simd(),
+    node: process.version,
+    platform: `${os.platform()}-${os.arch()}`,
+    cpu: os.cpus()[0]?.model,
+    date: new Date().toISOString(),
+    results,
+  };
+};
+
+const caseKey = (result) =>
+  `${result.name}/${result.size}/${result.mode}/${result.output}`;
+
+/* Cases where compute or total time moved by more than the threshold */
+const compareReports = (base, current, threshold) => {
+  const baseline = new Map(base.results.map((result) => [caseKey(result), result]));
+  const regressions = [];
+  const improvements = [];
+
+  for (const result of current.results) {
+    const before = baseline.get(caseKey(result));
+
+    if (!before || before.error || result.error) continue;
+
+    for (const metric of ["compute", "total"]) {
+      const change = ((result[metric] - before[metric]) / before[metric]) * 100;
+      const entry = {
+        case: caseKey(result),
+        metric,
+        before: before[metric],
+        after: result[metric],
+        change: Math.round(change * 10) / 10,
+      };
+
+      if (change > threshold) regressions.push(entry);
+      else if (change < -threshold) improvements.push(entry);
+    }
+  }
+
+  return { threshold, regressions, improvements };
+};
+
+const args = parseArgs(process.argv.slice(2));
+const readReport = (path) => JSON.parse(fs.readFileSync(path, "utf8"));
+
+let report;
+
+if (args.compare) {
+  const current =
+    args.compare.length > 1
+      ? readReport(args.compare[1])
+      : await runBenchmark(args);
+
+  report = compareReports(readReport(args.compare[0]), current, args.threshold);
+  process.exitCode = report.regressions.length > 0 ? 1 : 0;
+} else {
+  report = await runBenchmark(args);
+}
+
+if (args.output) fs.writeFileSync(args.output, JSON.stringify(report, null, 2));
+else console.log(JSON.stringify(report, null, 2));
@@ -2,8 +2,21 @@
   "targets": [
     {
       "target_name": "napi_talib",
+      "dependencies": ["kernels_avx2", "kernels_avx512", "ta_globals"],
       "sources": [
         "./src/binding.cpp",
+        "./src/columns.cpp",
+        "./src/direct.cpp",
+        "./src/executor.cpp",
+        "./src/kernels.cpp",
+        "./src/kernels_sse2.cpp",
+        "./src/pool.cpp",
+        "./src/resample.cpp",
+        "./src/rolling.cpp",
+        "./src/settings.cpp",
+        "./src/single.cpp",
+        "./src/stats.cpp",
+        "./src/stream.cpp",
         "./src/ta-lib/src/ta_abstract/frames/ta_frame.c",
         "./src/ta-lib/src/ta_abstract/tables/table_a.c",
         "./src/ta-lib/src/ta_abstract/tables/table_b.c",
@@ -35,7 +48,6 @@
         "./src/ta-lib/src/ta_abstract/ta_def_ui.c",
         "./src/ta-lib/src/ta_abstract/ta_func_api.c",
         "./src/ta-lib/src/ta_abstract/ta_group_idx.c",
-        "./src/ta-lib/src/ta_common/ta_global.c",
         "./src/ta-lib/src/ta_common/ta_retcode.c",
         "./src/ta-lib/src/ta_common/ta_version.c",
         "./src/ta-lib/src/ta_func/ta_utility.c",
@@ -210,6 +222,65 @@
         "./src/ta-lib/src/ta_abstract/tables",
         "./src/ta-lib/src/ta_common",
         "./src/ta-lib/src/ta_func"
+      ],
+      "cflags_c": ["-include", "<(module_root_dir)/src/ta_thread.h"],
+      "xcode_settings": {
+        "OTHER_CFLAGS": ["-include", "<(module_root_dir)/src/ta_thread.h"]
+      },
+      "msvs_settings": {
+        "VCCLCompilerTool": {
+          "ForcedIncludeFiles": ["<(module_root_dir)/src/ta_thread.h"]
+        }
+      }
+    },
+    {
+      "target_name": "ta_globals",
+      "type": "static_library",
+      "sources": [
+        "./src/ta_thread.c",
+        "./src/ta-lib/src/ta_common/ta_global.c"
+      ],
+      "include_dirs": [
+        "./src/ta-lib/include",
+        "./src/ta-lib/src/ta_abstract",
+        "./src/ta-lib/src/ta_common",
+        "./src/ta-lib/src/ta_func"
+      ]
+    },
+    {
+      "target_name": "kernels_avx2",
+      "type": "static_library",
+      "sources": ["./src/kernels_avx2.cpp"],
+      "conditions": [
+        [
+          "target_arch=='x64'",
+          {
+            "cflags_cc": ["-mavx2"],
+            "xcode_settings": { "OTHER_CPLUSPLUSFLAGS": ["-mavx2"] },
+            "msvs_settings": {
+              "VCCLCompilerTool": { "AdditionalOptions": ["/arch:AVX2"] }
+            }
+          }
+        ]
+      ]
+    },
+    {
+      "target_name": "kernels_avx512",
+      "type": "static_library",
+      "sources": ["./src/kernels_avx512.cpp"],
+      "conditions": [
+        [
+          "target_arch=='x64'",
+          {
+            "cflags_cc": ["-mavx512f", "-ffp-contract=off"],
+            "xcode_settings": {
+              "OTHER_CPLUSPLUSFLAGS": ["-mavx512f", "-ffp-contract=off"]
+            },
+            "msvs_settings": {
+              "VCCLCompilerTool": { "AdditionalOptions": ["/arch:AVX512"] }
+            }
+          }
+        ]
       ]
     }
   ]
@@ -37,18 +37,36 @@ const inputFlagToName = (flag) => {
   }
 };
 
-const genFuncArgsTypes = (funcInfo) => {
+const outputTypeToArray = (type) => {
+  switch (type) {
+    case "real":
+      return "Float64Array";
+
+    case "integer":
+      return "Int32Array";
+  }
+};
+
+const genOutputsTypes = (funcInfo) => {
+  const outputs = funcInfo.outputs.map((output) => {
+    return `${output.name}: ${outputTypeToArray(output.type)}`;
+  });
+
+  return `{${outputs.join("; ")}}`;
+};
+
+const genFuncArgsTypes = (funcInfo, outputs, async = false) => {
   const inputs = funcInfo.inputs
     .map((input) => {
       switch (input.type) {
         case "price":
           return input.flags.map(
-            (flag) => `${inputFlagToName(flag)}: number[]`
+            (flag) => `${inputFlagToName(flag)}: InputArray`
           );
 
         case "real":
         case "integer":
-          return `${input.name}: number[]`;
+          return `${input.name}: InputArray`;
       }
     })
     .flat(Infinity);
@@ -60,6 +78,18 @@ const genFuncArgsTypes = (funcInfo) => {
   opts.push("startIdx?: number");
   opts.push("endIdx?: number");
 
+  if (async) opts.push("signal?: AbortSignal");
+
+  switch (outputs) {
+    case "required":
+      opts.push(`outputs: ${genOutputsTypes(funcInfo)}`);
+      return `${inputs.join(", ")}, opts: {${opts.join("; ")}}`;
+
+    case "optional":
+      opts.push(`outputs?: ${genOutputsTypes(funcInfo)}`);
+      break;
+  }
+
   return `${inputs.join(", ")}, opts?: {${opts.join("; ")}}`;
 };
 
@@ -69,6 +99,14 @@ const genFuncReturnsTypes = (funcInfo) => {
     : `[${funcInfo.outputs.map(() => "number[]").join(", ")}]`;
 };
 
+const genFuncTypedReturnsTypes = (funcInfo) => {
+  return funcInfo.outputs.length === 1
+    ? outputTypeToArray(funcInfo.outputs[0].type)
+    : `[${funcInfo.outputs
+        .map((output) => outputTypeToArray(output.type))
+        .join(", ")}]`;
+};
+
 const getFirstName = (funcInfo) => {
   const input = funcInfo.inputs[0];
   return input.type === "price" ? inputFlagToName(input.flags[0]) : input.name;
@@ -97,54 +135,94 @@ const genCallInputs = (funcInfo) => {
 const genCallArgs = (funcInfo) => {
   const codes = [
     `name: "${funcInfo.name}"`,
-    "startIdx: opts?.startIdx ?? 0",
-    `endIdx: opts?.endIdx ?? ${getFirstName(funcInfo)}.length - 1`,
-    `params: Object.assign(${genCallInputs(funcInfo)}, opts ?? {})`,
+    "startIdx: options.startIdx ?? 0",
+    `endIdx: options.endIdx ?? ${getFirstName(funcInfo)}.length - 1`,
+    `params: Object.assign(${genCallInputs(funcInfo)}, options)`,
+    "outputs",
   ];
 
   return `{${codes.join(", ")}}`;
 };
 
-const genFuncReturns = (funcInfo) => {
+const genFuncReturns = (funcInfo, typed = false) => {
+  const fill = (name) =>
+    typed
+      ? `fillNaN(results.begIndex, Array.from(${name}!))`
+      : `fillNaN(results.begIndex, ${name}!)`;
+
+  return funcInfo.outputs.length === 1
+    ? fill(funcInfo.outputs[0].name)
+    : `[${funcInfo.outputs.map((output) => fill(output.name)).join(", ")}]`;
+};
+
+/* Positional arguments of the native thunk, see src/direct.cpp */
+const genDirectArgs = (funcInfo) => {
+  const inputs = funcInfo.inputs
+    .map((input) =>
+      input.type === "price" ? input.flags.map(inputFlagToName) : input.name
+    )
+    .flat(Infinity);
+
+  const opts = funcInfo.optInputs.map((input) => `options.${input.name}`);
+
+  return [...inputs, ...opts, "options.startIdx", "options.endIdx"].join(", ");
+};
+
+const genFuncTypedReturns = (funcInfo) => {
   return funcInfo.outputs.length === 1
-    ? `fillNaN(results.begIndex, ${funcInfo.outputs[0].name}!)`
+    ? `outputs.${funcInfo.outputs[0].name}`
     : `[${funcInfo.outputs
-        .map((output) => `fillNaN(results.begIndex, ${output.name}!)`)
+        .map((output) => `outputs.${output.name}`)
         .join(", ")}]`;
 };
 
 const genFuncBody = (funcInfo) => {
   const outputs = funcInfo.outputs.map((output) => output.name);
-  const codes = [
+  const codes = ["const { outputs, ...options } = { ...opts };"];
+
+  if (funcInfo.name in talib.direct) {
+    codes.push(
+      "if (!outputs) {",
+      `  const results = direct.${funcInfo.name}(${genDirectArgs(funcInfo)});`,
+      `  const {${outputs.join(", ")}} = results.results;`,
+      `  return ${genFuncReturns(funcInfo, true)};`,
+      "}"
+    );
+  }
+
+  codes.push(
     `const results = execute(${genCallArgs(funcInfo)});`,
+    `if (outputs) { return ${genFuncTypedReturns(funcInfo)}; }`,
     `const {${outputs.join(", ")}} = results.results;`,
-    `return ${genFuncReturns(funcInfo)};`,
-  ];
+    `return ${genFuncReturns(funcInfo)};`
+  );
   return codes.join("\n");
 };
 
 const genAsyncFuncBody = (funcInfo) => {
   const outputs = funcInfo.outputs.map((output) => output.name);
   const returns = genFuncReturnsTypes(funcInfo);
+  const typedReturns = genFuncTypedReturnsTypes(funcInfo);
 
   const codes = [
-    `return new Promise<${returns}>((resolve, reject) => {`,
-    `  execute(${genCallArgs(funcInfo)}, (error, results) => {`,
-    "    if (error) { return reject(error); }",
-    `    const {${outputs.join(", ")}} = results.results;`,
-    `    resolve(${genFuncReturns(funcInfo)});`,
-    "  });",
+    "const { outputs, signal, ...options } = { ...opts };",
+    `return executeAsync(${genCallArgs(funcInfo)}, { signal }).then((results): ${returns} | ${typedReturns} => {`,
+    `  if (outputs) { return ${genFuncTypedReturns(funcInfo)}; }`,
+    `  const {${outputs.join(", ")}} = results.results;`,
+    `  return ${genFuncReturns(funcInfo)};`,
     "});",
   ];
   return codes.join("\n");
 };
 
 const genFuncCode = (funcInfo) => {
-  const args = genFuncArgsTypes(funcInfo);
   const returns = genFuncReturnsTypes(funcInfo);
+  const typedReturns = genFuncTypedReturnsTypes(funcInfo);
 
   const codes = [
-    `export function ${funcInfo.name} (${args}): ${returns} {`,
+    `export function ${funcInfo.name} (${genFuncArgsTypes(funcInfo, "required")}): ${typedReturns};`,
+    `export function ${funcInfo.name} (${genFuncArgsTypes(funcInfo)}): ${returns};`,
+    `export function ${funcInfo.name} (${genFuncArgsTypes(funcInfo, "optional")}): ${returns} | ${typedReturns} {`,
     genFuncBody(funcInfo),
     "}",
   ];
@@ -153,11 +231,13 @@ const genFuncCode = (funcInfo) => {
 };
 
 const genAsyncFuncCode = (funcInfo) => {
-  const args = genFuncArgsTypes(funcInfo);
   const returns = genFuncReturnsTypes(funcInfo);
+  const typedReturns = genFuncTypedReturnsTypes(funcInfo);
 
   const codes = [
-    `export function ${funcInfo.name} (${args}): Promise<${returns}> {`,
+    `export function ${funcInfo.name} (${genFuncArgsTypes(funcInfo, "required", true)}): Promise<${typedReturns}>;`,
+    `export function ${funcInfo.name} (${genFuncArgsTypes(funcInfo, undefined, true)}): Promise<${returns}>;`,
+    `export function ${funcInfo.name} (${genFuncArgsTypes(funcInfo, "optional", true)}): Promise<${returns} | ${typedReturns}> {`,
     genAsyncFuncBody(funcInfo),
     "}",
   ];
@@ -165,10 +245,10 @@ const genAsyncFuncCode = (funcInfo) => {
   return codes.join("\n");
 };
 
-const genHeaderCode = () => {
+const genHeaderCode = (imports) => {
   const codes = [
     "/* This file is automatically generated by gencodes.js */",
-    "import { execute } from './index.js'",
+    `import { ${imports}, type InputArray } from './index.js'`,
     "const fillNaN = (count: number, array: number[]) =>",
     "  Array(count).fill(NaN).concat(array);",
   ];
@@ -177,7 +257,7 @@ const genHeaderCode = () => {
 };
 
 const genFuncsCodes = () => {
-  const codes = [genHeaderCode()];
+  const codes = [genHeaderCode("execute, direct")];
 
   talib.getFunctions().forEach((funcName) => {
     const funcInfo = talib.explain(funcName);
@@ -188,7 +268,7 @@ const genFuncsCodes = () => {
 };
 
 const genPromisesCodes = () => {
-  const codes = [genHeaderCode()];
+  const codes = [genHeaderCode("executeAsync")];
 
   talib.getFunctions().forEach((funcName) => {
     const funcInfo = talib.explain(funcName);
@@ -198,9 +278,21 @@ const genPromisesCodes = () => {
   return codes.join("\n");
 };
 
+/* Native thunks calling TA_<name> directly, see src/direct.cpp */
+const genDirectCodes = () => {
+  const codes = ["/* This file is automatically generated by gencodes.js */"];
+
+  [...talib.getFunctions()].sort().forEach((funcName) => {
+    codes.push(`DIRECT(${funcName})`);
+  });
+
+  return codes.join("\n") + "\n";
+};
+
 const genCodes = () => {
   fs.writeFileSync("functions.ts", genFuncsCodes());
   fs.writeFileSync("promises.ts", genPromisesCodes());
+  fs.writeFileSync("src/direct_table.h", genDirectCodes());
 };
 
 genCodes();
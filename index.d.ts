@@ -18,37 +18,266 @@ export declare function getFunctionGroups(): Record<string, string[]>;
 /** Get functions */
 export declare function getFunctions(): string[];
 
-/** Set unstable period function */
+/** Set the default unstable period, calls already started keep theirs */
 export declare function setUnstablePeriod(
   funcId: types.FuncUnstId,
   period: number
 ): void;
 
-/** Set compatibility function */
+/** Set the default compatibility, calls already started keep theirs */
 export declare function setCompatibility(value: types.Compatibility): void;
 
 /** Get function infomation */
 export declare function explain(funcName: string): types.FuncInfo;
 
+/** Get the number of inputs consumed before the first output, unstable period included */
+export declare function lookback(
+  funcName: string,
+  optInputs?: { [name: string]: number },
+  settings?: types.FuncSettings
+): number;
+
 /** Execute sync function */
+export declare function execute(
+  param: types.FuncParam & { typed: true }
+): types.FuncResult<Float64Array | Int32Array>;
+export declare function execute(
+  param: types.FuncParam & { outputs: types.FuncOutputs }
+): types.FuncResult<types.OutputArray>;
 export declare function execute(param: types.FuncParam): types.FuncResult;
 
 /** Execute async function */
+export declare function execute(
+  param: types.FuncParam & { typed: true },
+  callback: (
+    error: Error | undefined,
+    result: types.FuncResult<Float64Array | Int32Array>
+  ) => void
+): void;
+export declare function execute(
+  param: types.FuncParam & { outputs: types.FuncOutputs },
+  callback: (
+    error: Error | undefined,
+    result: types.FuncResult<types.OutputArray>
+  ) => void
+): void;
 export declare function execute(
   param: types.FuncParam,
   callback: (error: Error | undefined, result: types.FuncResult) => void
 ): void;
 
+/** Execute sync functions in one native call */
+export declare function executeBatch(
+  jobs: types.FuncParam[],
+  options?: types.BatchOptions
+): types.FuncResult<types.OutputArray>[];
+
+/** Execute async functions in one native work item */
+export declare function executeBatch(
+  jobs: types.FuncParam[],
+  callback: (
+    error: Error | undefined,
+    results: types.FuncResult<types.OutputArray>[]
+  ) => void
+): void;
+export declare function executeBatch(
+  jobs: types.FuncParam[],
+  options: types.BatchOptions,
+  callback: (
+    error: Error | undefined,
+    results: types.FuncResult<types.OutputArray>[]
+  ) => void
+): void;
+
+/** Execute one function over many series on the native thread pool */
+export declare function executeUniverse(
+  spec: types.UniverseSpec,
+  series: types.SeriesInputs[]
+): types.FuncResult<types.OutputArray>[];
+
+/** Execute one function over many series, with a single completion */
+export declare function executeUniverse(
+  spec: types.UniverseSpec,
+  series: types.SeriesInputs[],
+  callback: (
+    error: Error | undefined,
+    results: types.FuncResult<types.OutputArray>[]
+  ) => void
+): void;
+
+/** Execute one function over a grid of optional inputs on the native thread pool */
+export declare function executeSweep(
+  spec: types.SweepSpec,
+  grid: types.SweepGrid
+): types.SweepResult;
+
+/** Execute a parameter sweep, with a single completion */
+export declare function executeSweep(
+  spec: types.SweepSpec,
+  grid: types.SweepGrid,
+  callback: (error: Error | undefined, result: types.SweepResult) => void
+): void;
+
+/** Execute async function, the promise rejects with the signal's reason once aborted */
+export declare function executeAsync(
+  param: types.FuncParam & { typed: true },
+  options?: types.AsyncOptions
+): Promise<types.FuncResult<Float64Array | Int32Array>>;
+export declare function executeAsync(
+  param: types.FuncParam & { outputs: types.FuncOutputs },
+  options?: types.AsyncOptions
+): Promise<types.FuncResult<types.OutputArray>>;
+export declare function executeAsync(
+  param: types.FuncParam,
+  options?: types.AsyncOptions
+): Promise<types.FuncResult>;
+
+/** Execute async functions in one native work item, aborting skips the jobs not started */
+export declare function executeBatchAsync(
+  jobs: types.FuncParam[],
+  options?: types.BatchOptions & types.AsyncOptions
+): Promise<types.FuncResult<types.OutputArray>[]>;
+
+/** Execute one function over many series, aborting skips the series not started */
+export declare function executeUniverseAsync(
+  spec: types.UniverseSpec,
+  series: types.SeriesInputs[],
+  options?: types.AsyncOptions
+): Promise<types.FuncResult<types.OutputArray>[]>;
+
+/** Execute a parameter sweep, aborting skips the rows not started */
+export declare function executeSweepAsync(
+  spec: types.SweepSpec,
+  grid: types.SweepGrid,
+  options?: types.AsyncOptions
+): Promise<types.SweepResult>;
+
+/** Execute a graph of functions natively, stage outputs never leave native memory */
+export declare function executePipeline(
+  spec: types.PipelineSpec
+): types.PipelineResult;
+
+/** Execute a graph of functions on the native thread pool */
+export declare function executePipeline(
+  spec: types.PipelineSpec,
+  callback: (error: Error | undefined, result: types.PipelineResult) => void
+): void;
+
+/** Run many candlestick patterns over the same OHLC, marshalled once, in one call */
+export declare function scanCandles(
+  spec: types.CandleScanSpec
+): types.CandleScanResult;
+
+/** Run many candlestick patterns on the native thread pool */
+export declare function scanCandles(
+  spec: types.CandleScanSpec,
+  callback: (error: Error | undefined, result: types.CandleScanResult) => void
+): void;
+
+/** Resolve a function and its optional inputs once, for repeated runs */
+export declare function prepare(
+  funcName: string,
+  optInputs?: { [name: string]: number },
+  settings?: types.FuncSettings
+): types.PreparedFunction;
+
+/** Copy columns once into native memory, e.g. { open, high, low, close, volume } */
+export declare function frame(columns: {
+  [column: string]: types.InputArray;
+}): types.Frame;
+
+/** Aggregate base bars into a frame by bar count or timestamp bucket */
+export declare function resample(spec: types.ResampleSpec): types.Resampler;
+
+/** Map a column file, Float64 columns are read by every call without copying */
+export declare function mapColumns(path: string): types.MappedColumns;
+
+/** Write equal length columns to a file readable by mapColumns */
+export declare function writeColumns(
+  path: string,
+  columns: { [column: string]: types.InputArray }
+): void;
+
+/** Create a stateful indicator, seeded with history and updated bar by bar */
+export declare function stream(
+  funcName: string,
+  optInputs?: { [name: string]: number },
+  history?: types.SeriesInputs,
+  settings?: types.FuncSettings
+): types.StreamIndicator;
+
+/** Resize the native thread pool used by every async call, shared by all workers */
+export declare function setExecutorOptions(
+  options: types.ExecutorOptions
+): void;
+
+/** Get native thread pool counters */
+export declare function getExecutorStats(): types.ExecutorStats;
+
+/** Reset native thread pool counters */
+export declare function resetExecutorStats(): void;
+
+/** Get native buffer pool counters */
+export declare function getPoolStats(): types.PoolStats;
+
+/** Reset native buffer pool counters */
+export declare function resetPoolStats(): void;
+
+/** Free cached native buffers, returns the number of bytes released */
+export declare function trimPool(): number;
+
+/** Get per function call counters and phase time histograms */
+export declare function stats(): types.Stats;
+
+/** Clear the per function counters */
+export declare function resetStats(): void;
+
+/** Switch the per function counters on or off, they are off by default */
+export declare function setStatsEnabled(enabled: boolean): void;
+
+/** Positional entry points calling each TA-Lib function directly, e.g. direct.SMA(inReal, 30) */
+export declare const direct: { [funcName: string]: types.DirectFunction };
+
 /** Get TA-Lib version */
 export declare function version(): string;
 
+/** Get the instruction set of the vectorized math and price kernels, "none" when they are not used */
+export declare function simd(): string;
+
 export default {
   getFunctionGroups,
   getFunctions,
   setUnstablePeriod,
   setCompatibility,
   explain,
+  lookback,
   execute,
+  executeBatch,
+  executeUniverse,
+  executeSweep,
+  executeAsync,
+  executeBatchAsync,
+  executeUniverseAsync,
+  executeSweepAsync,
+  executePipeline,
+  scanCandles,
+  prepare,
+  stream,
+  frame,
+  resample,
+  mapColumns,
+  writeColumns,
+  setExecutorOptions,
+  getExecutorStats,
+  resetExecutorStats,
+  getPoolStats,
+  resetPoolStats,
+  trimPool,
+  stats,
+  resetStats,
+  setStatsEnabled,
+  direct,
   version,
+  simd,
   ...types,
 };
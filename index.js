@@ -49,7 +49,34 @@ export const getFunctions = native.getFunctions;
 export const setUnstablePeriod = native.setUnstablePeriod;
 export const setCompatibility = native.setCompatibility;
 export const explain = native.explain;
+export const lookback = native.lookback;
 export const execute = native.execute;
+export const executeBatch = native.executeBatch;
+export const executeUniverse = native.executeUniverse;
+export const executeSweep = native.executeSweep;
+export const executeAsync = native.executeAsync;
+export const executeBatchAsync = native.executeBatchAsync;
+export const executeUniverseAsync = native.executeUniverseAsync;
+export const executeSweepAsync = native.executeSweepAsync;
+export const executePipeline = native.executePipeline;
+export const scanCandles = native.scanCandles;
+export const prepare = native.prepare;
+export const stream = native.stream;
+export const frame = native.frame;
+export const resample = native.resample;
+export const mapColumns = native.mapColumns;
+export const writeColumns = native.writeColumns;
+export const setExecutorOptions = native.setExecutorOptions;
+export const getExecutorStats = native.getExecutorStats;
+export const resetExecutorStats = native.resetExecutorStats;
+export const getPoolStats = native.getPoolStats;
+export const resetPoolStats = native.resetPoolStats;
+export const trimPool = native.trimPool;
+export const stats = native.stats;
+export const resetStats = native.resetStats;
+export const setStatsEnabled = native.setStatsEnabled;
+export const direct = native.direct;
 export const version = native.version;
+export const simd = native.simd;
 
 export default Object.assign(native, types);
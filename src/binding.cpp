@@ -12,10 +12,29 @@
 #include "ta_abstract.h"
 #include "ta_func.h"
 #include "ta_utility.h"
+#include "columns.h"
+#include "direct.h"
+#include "executor.h"
+#include "kernels.h"
+#include "pool.h"
+#include "resample.h"
+#include "rolling.h"
+#include "settings.h"
+#include "single.h"
+#include "stats.h"
+#include "stream.h"
+#include <math.h>
 #include <node_api.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <string>
 #include <vector>
 
 #define arraysize(a) ((int)(sizeof(a) / sizeof(*a)))
@@ -36,6 +55,22 @@ static void checkStatus(napi_env env, napi_status status, const char *file, int
 #define DECLARE_NAPI_METHOD_(name, method) {name, 0, method, 0, 0, 0, napi_default, 0}
 #define DECLARE_NAPI_METHOD(method) DECLARE_NAPI_METHOD_(#method, method)
 
+/* Inputs already marshalled by earlier jobs of the same batch */
+typedef struct InputCache {
+  std::vector<napi_value> arrays;
+  std::vector<void *> buffers;
+  std::vector<size_t> lengths;
+  std::vector<bool> integers;
+} InputCache;
+
+/* Columns kept in native memory across calls, read in place by every function */
+typedef struct FrameData {
+  std::vector<std::string> names;
+  std::vector<std::vector<double>> columns;
+  size_t length;
+  int busy;
+} FrameData;
+
 typedef struct WorkData {
   TA_FuncHandle *funcHandle;
   TA_ParamHolder *funcParams;
@@ -44,10 +79,34 @@ typedef struct WorkData {
   int endIdx;
   int outBegIdx;
   int outNBElement;
+  int outOffset;
+  int tail;
   unsigned int nbOutput;
+  size_t inLength;
+  size_t inOffset;
+  bool async;
+  bool typed;
+  bool profile;
+  int64_t parseTime;
+  int64_t computeTime;
+  int64_t marshalTime;
+  int64_t queueTime;
+  size_t inputBytes;
+  InputCache *inputCache;
+  FrameData *frame;
+  const TaSettings *settings;
+  SingleFunc singleFunc;
+  KernelFunc kernel;
+  RollingFunc rolling;
+  std::vector<const float *> singleInputs;
+  std::vector<const double *> realInputs;
+  std::vector<double> optInputs;
   std::vector<double *> outReals;
   std::vector<int *> outIntegers;
+  std::vector<napi_ref> outArrays;
+  std::vector<void *> outBuffers;
   std::vector<void *> garbage;
+  std::vector<napi_ref> refs;
 
   WorkData() {
     funcHandle = nullptr;
@@ -58,15 +117,221 @@ typedef struct WorkData {
     nbOutput = 0;
     outBegIdx = 0;
     outNBElement = 0;
+    outOffset = 0;
+    tail = 0;
+    inLength = SIZE_MAX;
+    inOffset = 0;
+    async = false;
+    typed = false;
+    profile = false;
+    parseTime = computeTime = marshalTime = queueTime = -1;
+    inputBytes = 0;
+    inputCache = nullptr;
+    frame = nullptr;
+    settings = nullptr;
+    singleFunc = nullptr;
+    kernel = nullptr;
+    rolling = nullptr;
   }
 } WorkData;
 
+/* Work queued on the executor, completed on the JS thread through the addon's tsfn */
+typedef struct AddonData AddonData;
+
+/* Delivered through a callback, or a promise when 'deferred' is set. An
+ * aborted task skips the work that has not started yet. */
+typedef struct AsyncTask {
+  void (*execute)(void *data);
+  void (*complete)(napi_env env, void *data);
+  void *data;
+  AddonData *addonData;
+  int64_t queuedAt;
+  int64_t queueTime;
+  napi_deferred deferred;
+  napi_ref signal;
+  napi_ref listener;
+  std::atomic<bool> aborted;
+
+  AsyncTask() {
+    execute = nullptr;
+    complete = nullptr;
+    data = nullptr;
+    addonData = nullptr;
+    queuedAt = queueTime = 0;
+    deferred = nullptr;
+    signal = nullptr;
+    listener = nullptr;
+    aborted = false;
+  }
+} AsyncTask;
+
+/* One per environment, the main thread and each worker_threads Worker */
+typedef struct AddonData {
+  napi_threadsafe_function tsfn;
+  int pending;
+  int running;
+  std::mutex mutex;
+  std::condition_variable idle;
+  napi_ref preparedConstructor;
+  napi_ref streamConstructor;
+  napi_ref frameConstructor;
+  napi_ref resamplerConstructor;
+} AddonData;
+
+/* Value flowing through a pipeline, either a series input or a node output */
+typedef struct PipelineSlot {
+  char name[64];
+  double *data;
+  int begIdx;
+  int lastUse;
+  bool integer;
+  bool owned;
+  bool result;
+} PipelineSlot;
+
+typedef struct PipelineNode {
+  char id[64];
+  TA_FuncHandle *funcHandle;
+  const TA_FuncInfo *funcInfo;
+  TA_ParamHolder *funcParams;
+  int lookback;
+  bool result;
+  std::vector<int> inputs;
+  std::vector<int> outputs;
+} PipelineNode;
+
+/* Nodes run in declaration order on full-length buffers, recycled through 'pool' once consumed */
+typedef struct PipelineData {
+  napi_ref cbref;
+  AsyncTask task;
+  TA_RetCode retCode;
+  WorkData workData;
+  std::vector<PipelineSlot> slots;
+  std::vector<PipelineNode> nodes;
+  std::vector<double *> buffers;
+  std::vector<double *> pool;
+  std::vector<int *> integers;
+
+  PipelineData() {
+    cbref = nullptr;
+    retCode = TA_SUCCESS;
+  }
+} PipelineData;
+
+/* Pattern Recognition functions over the same OHLC, one Int8 row per pattern.
+ * Only the inputs are shared, each CDL function keeps its own candle averages. */
+typedef struct CandleScanData {
+  napi_ref cbref;
+  AsyncTask task;
+  WorkData workData;
+  double *open;
+  double *high;
+  double *low;
+  double *close;
+  size_t bars;
+  int8_t *matrix;
+  std::vector<const char *> names;
+  std::vector<TA_ParamHolder *> funcParams;
+  std::vector<TA_RetCode> retCodes;
+
+  CandleScanData() {
+    cbref = nullptr;
+    open = high = low = close = nullptr;
+    bars = 0;
+    matrix = nullptr;
+  }
+} CandleScanData;
+
+/* Parameter infos and native paths of a function, read once from the abstract tables */
+typedef struct FuncLayout {
+  TA_FuncHandle *funcHandle;
+  const TA_FuncInfo *funcInfo;
+  std::vector<const TA_InputParameterInfo *> inputs;
+  std::vector<const TA_OptInputParameterInfo *> optInputs;
+  std::vector<const TA_OutputParameterInfo *> outputs;
+  SingleFunc singleFunc;
+  KernelFunc kernel;
+  RollingFunc rolling;
+} FuncLayout;
+
+/* Function resolved once by prepare(), its ParamHolder keeps the optional inputs between runs */
+typedef struct PreparedFunc {
+  const FuncLayout *layout;
+  TA_ParamHolder *funcParams;
+  const TaSettings *settings;
+  std::vector<double> optInputs;
+} PreparedFunc;
+
+/* Indicator fed bar by bar. The history is kept to verify the native state
+ * machine once, and to recompute functions that have none. A verified state
+ * machine runs on without it. */
+typedef struct StreamData {
+  TA_FuncHandle *funcHandle;
+  const TA_FuncInfo *funcInfo;
+  TA_ParamHolder *funcParams;
+  const TaSettings *settings;
+  Stream *stream;
+  int lookback;
+  bool verified;
+  size_t length;
+  std::vector<const char *> names;
+  std::vector<std::vector<double>> columns;
+  std::vector<double> optInputs;
+  std::vector<double> bar;
+  std::vector<double> outputs;
+  std::vector<std::vector<double>> outReals;
+  std::vector<std::vector<int>> outIntegers;
+  std::vector<bool> outIsInteger;
+  std::vector<size_t> outSlots;
+
+  StreamData() {
+    funcHandle = nullptr;
+    funcInfo = nullptr;
+    funcParams = nullptr;
+    settings = nullptr;
+    stream = nullptr;
+    lookback = 0;
+    verified = false;
+    length = 0;
+  }
+} StreamData;
+
+/* Bars produced by the state machine before it is compared with TA_CallFunc */
+#define STREAM_VERIFY_BARS 32
+
 typedef struct AsyncWorkData {
   napi_ref cbref;
-  napi_async_work worker;
+  AsyncTask task;
   WorkData workData;
 } AsyncWorkData;
 
+/* Grid of optional inputs, each job of the batch writes one row of the matrices */
+typedef struct SweepData {
+  int columns;
+  std::vector<unsigned int> optIndexes;
+  std::vector<std::vector<double>> values;
+  std::vector<void *> matrices;
+
+  SweepData() {
+    columns = 0;
+  }
+} SweepData;
+
+typedef struct BatchWorkData {
+  napi_ref cbref;
+  AsyncTask task;
+  bool parallel;
+  InputCache inputCache;
+  std::vector<WorkData> jobs;
+  SweepData *sweep;
+
+  BatchWorkData() {
+    cbref = nullptr;
+    parallel = false;
+    sweep = nullptr;
+  }
+} BatchWorkData;
+
 static napi_status setArrayString(napi_env env, napi_value array, unsigned int index, const char *string) {
   napi_value value;
 
@@ -88,6 +353,11 @@ static napi_status setArrayInt32(napi_env env, napi_value array, unsigned int in
   return napi_set_element(env, array, index, value);
 }
 
+/* Nanoseconds on a monotonic clock */
+static int64_t now(void) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 static napi_status setNamedPropertyString(napi_env env, napi_value object, const char *name, const char *string) {
   napi_value value;
 
@@ -110,16 +380,13 @@ static napi_status setNamedPropertyInt32(napi_env env, napi_value object, const
 }
 
 static bool getNamedProperty(napi_env env, napi_value object, const char *name, napi_value *value) {
-  bool hasProperty;
-
-  CHECK(napi_has_named_property(env, object, name, &hasProperty));
-
-  if (!hasProperty)
-    return false;
+  napi_valuetype valuetype;
 
+  /* A single lookup, absent properties read as undefined */
   CHECK(napi_get_named_property(env, object, name, value));
+  CHECK(napi_typeof(env, *value, &valuetype));
 
-  return true;
+  return valuetype != napi_undefined;
 }
 
 static bool getNamedPropertyString(napi_env env, napi_value object, const char *name, char *buf, size_t bufsize) {
@@ -155,54 +422,310 @@ static bool getNamedPropertyInt32(napi_env env, napi_value object, const char *n
   return true;
 }
 
-static bool getNamedPropertyArray(napi_env env, napi_value object, const char *name, napi_value *array) {
-  bool isArray;
+static bool getNamedPropertyBool(napi_env env, napi_value object, const char *name, bool *boolean) {
+  napi_value value;
 
-  if (!getNamedProperty(env, object, name, array))
+  if (!getNamedProperty(env, object, name, &value))
     return false;
 
-  CHECK(napi_is_array(env, *array, &isArray));
+  CHECK(napi_coerce_to_bool(env, value, &value));
+  CHECK(napi_get_value_bool(env, value, boolean));
 
-  return isArray;
+  return true;
 }
 
-static double *getNamedPropertyDoubleArray(napi_env env, napi_value object, const char *name) {
-  napi_value array, value;
-  unsigned int length;
+static bool getTypedArray(napi_env env, napi_value value, napi_typedarray_type *type, size_t *length, void **data) {
+  bool isTypedArray;
+
+  CHECK(napi_is_typedarray(env, value, &isTypedArray));
+
+  if (!isTypedArray)
+    return false;
+
+  CHECK(napi_get_typedarray_info(env, value, type, length, data, nullptr, nullptr));
+
+  return true;
+}
+
+template <typename T, typename U>
+static void convertArray(const U *source, T *target, size_t length) {
+  for (size_t i = 0; i < length; ++i)
+    target[i] = (T)source[i];
+}
+
+template <typename T>
+/* Converts 'length' elements of the typed array data, starting at element 'offset' */
+static bool convertTypedArray(napi_typedarray_type type, const void *source, size_t offset, T *target, size_t length) {
+  switch (type) {
+  case napi_int8_array:
+    convertArray((const int8_t *)source + offset, target, length);
+    return true;
+
+  case napi_uint8_array:
+  case napi_uint8_clamped_array:
+    convertArray((const uint8_t *)source + offset, target, length);
+    return true;
+
+  case napi_int16_array:
+    convertArray((const int16_t *)source + offset, target, length);
+    return true;
+
+  case napi_uint16_array:
+    convertArray((const uint16_t *)source + offset, target, length);
+    return true;
+
+  case napi_int32_array:
+    convertArray((const int32_t *)source + offset, target, length);
+    return true;
+
+  case napi_uint32_array:
+    convertArray((const uint32_t *)source + offset, target, length);
+    return true;
+
+  case napi_float32_array:
+    convertArray((const float *)source + offset, target, length);
+    return true;
+
+  case napi_float64_array:
+    convertArray((const double *)source + offset, target, length);
+    return true;
+
+  case napi_bigint64_array:
+    convertArray((const int64_t *)source + offset, target, length);
+    return true;
+
+  case napi_biguint64_array:
+    convertArray((const uint64_t *)source + offset, target, length);
+    return true;
+
+  default:
+    return false;
+  }
+}
+
+static void pinValue(napi_env env, napi_value value, WorkData *workData) {
+  napi_ref ref;
+
+  if (!workData->async)
+    return;
+
+  CHECK(napi_create_reference(env, value, 1, &ref));
+  workData->refs.push_back(ref);
+}
+
+static double *marshalDoubleArray(napi_env env, napi_value array, WorkData *workData, size_t *length) {
+  napi_value value;
+  napi_typedarray_type type;
+  unsigned int count;
+  bool isArray;
+  void *data;
   double *numbers;
+  size_t offset = workData->inOffset;
+
+  if (getTypedArray(env, array, &type, length, &data)) {
+    /* Tail runs only see the elements from 'inOffset' on, a shorter input has none */
+    offset = *length < offset ? *length : offset;
+    *length -= offset;
+
+    /* Float64Array is handed to TA-Lib as is, without copying */
+    if (type == napi_float64_array) {
+      pinValue(env, array, workData);
+      return (double *)data + offset;
+    }
+
+    numbers = (double *)poolAlloc(sizeof(double) * (*length > 0 ? *length : 1));
 
-  if (!getNamedPropertyArray(env, object, name, &array))
+    if (!convertTypedArray(type, data, offset, numbers, *length)) {
+      poolFree(numbers);
+      return nullptr;
+    }
+
+    workData->inputBytes += sizeof(double) * *length;
+    workData->garbage.push_back(numbers);
+    return numbers;
+  }
+
+  CHECK(napi_is_array(env, array, &isArray));
+
+  if (!isArray)
     return nullptr;
 
-  CHECK(napi_get_array_length(env, array, &length));
+  CHECK(napi_get_array_length(env, array, &count));
+  offset = count < offset ? count : offset;
+  *length = count - offset;
 
-  numbers = (double *)malloc(sizeof(double) * length);
+  numbers = (double *)poolAlloc(sizeof(double) * (*length > 0 ? *length : 1));
 
-  for (unsigned int i = 0; i < length; ++i) {
-    CHECK(napi_get_element(env, array, i, &value));
+  for (size_t i = 0; i < *length; ++i) {
+    CHECK(napi_get_element(env, array, (uint32_t)(i + offset), &value));
     CHECK(napi_get_value_double(env, value, &numbers[i]));
   }
 
+  workData->inputBytes += sizeof(double) * *length;
+  workData->garbage.push_back(numbers);
   return numbers;
 }
 
-static int *getNamedPropertyInt32Array(napi_env env, napi_value object, const char *name) {
-  napi_value array, value;
-  unsigned int length;
+static int *marshalInt32Array(napi_env env, napi_value array, WorkData *workData, size_t *length) {
+  napi_value value;
+  napi_typedarray_type type;
+  unsigned int count;
+  bool isArray;
+  void *data;
   int *numbers;
+  size_t offset = workData->inOffset;
+
+  if (getTypedArray(env, array, &type, length, &data)) {
+    /* Tail runs only see the elements from 'inOffset' on, a shorter input has none */
+    offset = *length < offset ? *length : offset;
+    *length -= offset;
+
+    /* Int32Array is handed to TA-Lib as is, without copying */
+    if (type == napi_int32_array) {
+      pinValue(env, array, workData);
+      return (int *)data + offset;
+    }
+
+    numbers = (int *)poolAlloc(sizeof(int) * (*length > 0 ? *length : 1));
+
+    if (!convertTypedArray(type, data, offset, numbers, *length)) {
+      poolFree(numbers);
+      return nullptr;
+    }
+
+    workData->inputBytes += sizeof(int) * *length;
+    workData->garbage.push_back(numbers);
+    return numbers;
+  }
+
+  CHECK(napi_is_array(env, array, &isArray));
 
-  if (!getNamedPropertyArray(env, object, name, &array))
+  if (!isArray)
     return nullptr;
 
-  CHECK(napi_get_array_length(env, array, &length));
+  CHECK(napi_get_array_length(env, array, &count));
+  offset = count < offset ? count : offset;
+  *length = count - offset;
 
-  numbers = (int *)malloc(sizeof(int) * length);
+  numbers = (int *)poolAlloc(sizeof(int) * (*length > 0 ? *length : 1));
 
-  for (unsigned int i = 0; i < length; ++i) {
-    CHECK(napi_get_element(env, array, i, &value));
+  for (size_t i = 0; i < *length; ++i) {
+    CHECK(napi_get_element(env, array, (uint32_t)(i + offset), &value));
     CHECK(napi_get_value_int32(env, value, &numbers[i]));
   }
 
+  workData->inputBytes += sizeof(int) * *length;
+  workData->garbage.push_back(numbers);
+  return numbers;
+}
+
+static void *findCachedInput(napi_env env, const InputCache *inputCache, napi_value array, bool integer, size_t *length) {
+  bool isEqual;
+
+  for (size_t i = 0; i < inputCache->arrays.size(); ++i) {
+    if (inputCache->integers[i] != integer)
+      continue;
+
+    CHECK(napi_strict_equals(env, inputCache->arrays[i], array, &isEqual));
+
+    if (isEqual) {
+      *length = inputCache->lengths[i];
+      return inputCache->buffers[i];
+    }
+  }
+
+  return nullptr;
+}
+
+static void cacheInput(InputCache *inputCache, napi_value array, void *buffer, size_t length, bool integer) {
+  inputCache->arrays.push_back(array);
+  inputCache->buffers.push_back(buffer);
+  inputCache->lengths.push_back(length);
+  inputCache->integers.push_back(integer);
+}
+
+/* With a frame, an input is the column of the same name, or the column named by a string */
+static double *getFrameColumn(napi_env env, napi_value object, const char *name, const WorkData *workData, size_t *length) {
+  napi_value value;
+  napi_valuetype valuetype;
+  char column[64] = {0};
+
+  if (!workData->frame)
+    return nullptr;
+
+  if (getNamedProperty(env, object, name, &value)) {
+    CHECK(napi_typeof(env, value, &valuetype));
+
+    if (valuetype != napi_string)
+      return nullptr;
+
+    CHECK(napi_get_value_string_utf8(env, value, column, sizeof(column), nullptr));
+  } else {
+    snprintf(column, sizeof(column), "%s", name);
+  }
+
+  for (size_t i = 0; i < workData->frame->names.size(); ++i) {
+    if (workData->frame->names[i] == column) {
+      *length = workData->frame->length;
+      return workData->frame->columns[i].data();
+    }
+  }
+
+  return nullptr;
+}
+
+static double *getNamedPropertyDoubleArray(napi_env env, napi_value object, const char *name, WorkData *workData) {
+  napi_value array;
+  size_t length = 0;
+  double *numbers = nullptr;
+
+  if ((numbers = getFrameColumn(env, object, name, workData, &length))) {
+    size_t offset = length < workData->inOffset ? length : workData->inOffset;
+
+    length -= offset;
+    workData->inLength = length < workData->inLength ? length : workData->inLength;
+
+    return numbers + offset;
+  }
+
+  if (!getNamedProperty(env, object, name, &array))
+    return nullptr;
+
+  if (workData->inputCache)
+    numbers = (double *)findCachedInput(env, workData->inputCache, array, false, &length);
+
+  if (!numbers) {
+    if (!(numbers = marshalDoubleArray(env, array, workData, &length)))
+      return nullptr;
+
+    if (workData->inputCache)
+      cacheInput(workData->inputCache, array, numbers, length, false);
+  }
+
+  workData->inLength = length < workData->inLength ? length : workData->inLength;
+  return numbers;
+}
+
+static int *getNamedPropertyInt32Array(napi_env env, napi_value object, const char *name, WorkData *workData) {
+  napi_value array;
+  size_t length = 0;
+  int *numbers = nullptr;
+
+  if (!getNamedProperty(env, object, name, &array))
+    return nullptr;
+
+  if (workData->inputCache)
+    numbers = (int *)findCachedInput(env, workData->inputCache, array, true, &length);
+
+  if (!numbers) {
+    if (!(numbers = marshalInt32Array(env, array, workData, &length)))
+      return nullptr;
+
+    if (workData->inputCache)
+      cacheInput(workData->inputCache, array, numbers, length, true);
+  }
+
+  workData->inLength = length < workData->inLength ? length : workData->inLength;
   return numbers;
 }
 
@@ -308,7 +831,13 @@ static napi_value setUnstablePeriod(napi_env env, napi_callback_info info) {
   CHECK(napi_get_value_int32(env, argv[0], (int *)&funcId));
   CHECK(napi_get_value_int32(env, argv[1], &unstablePeriod));
 
-  if (TA_SUCCESS != (retCode = TA_SetUnstablePeriod(funcId, unstablePeriod))) {
+  if (unstablePeriod < 0) {
+    napi_throw_range_error(env, nullptr, "The second argument must be a non-negative Integer");
+    return undefined;
+  }
+
+  /* Running calls keep the settings they were started with */
+  if (TA_SUCCESS != (retCode = settingsSetDefaultUnstablePeriod(funcId, (unsigned int)unstablePeriod))) {
     napi_value error;
 
     CHECK(createTAError(env, retCode, &error));
@@ -339,7 +868,7 @@ static napi_value setCompatibility(napi_env env, napi_callback_info info) {
 
   CHECK(napi_get_value_int32(env, argv, (int *)&value));
 
-  if (TA_SUCCESS != (retCode = TA_SetCompatibility(value))) {
+  if (TA_SUCCESS != (retCode = settingsSetDefaultCompatibility(value))) {
     napi_value error;
 
     CHECK(createTAError(env, retCode, &error));
@@ -351,6 +880,125 @@ static napi_value setCompatibility(napi_env env, napi_callback_info info) {
   return undefined;
 }
 
+/* TA_FuncUnstId order */
+static const char *unstableNames[] = {
+    "ADX", "ADXR", "ATR", "CMO", "DX", "EMA", "HT_DCPERIOD", "HT_DCPHASE",
+    "HT_PHASOR", "HT_SINE", "HT_TRENDLINE", "HT_TRENDMODE", "IMI", "KAMA",
+    "MAMA", "MFI", "MINUS_DI", "MINUS_DM", "NATR", "PLUS_DI", "PLUS_DM", "RSI",
+    "STOCHRSI", "T3", "ALL",
+};
+
+/* A key of 'unstablePeriod', either a FuncUnstId name or its value */
+static int findUnstableId(const char *key) {
+  char *end;
+  long value = strtol(key, &end, 10);
+
+  if (end != key && *end == '\0')
+    return value >= 0 && value < arraysize(unstableNames) ? (int)value : -1;
+
+  for (int i = 0; i < arraysize(unstableNames); ++i)
+    if (strcmp(key, unstableNames[i]) == 0)
+      return i;
+
+  return -1;
+}
+
+static bool parseUnstablePeriods(napi_env env, napi_value object, TaSettings *settings, napi_value *error) {
+  napi_value keys, key, value;
+  napi_valuetype valuetype;
+  unsigned int length;
+  int periods[arraysize(unstableNames)];
+  char name[64];
+
+  CHECK(napi_typeof(env, object, &valuetype));
+
+  if (valuetype != napi_object) {
+    CHECK(createError(env, "Field 'unstablePeriod' must be a Object", error));
+    return false;
+  }
+
+  CHECK(napi_get_property_names(env, object, &keys));
+  CHECK(napi_get_array_length(env, keys, &length));
+
+  for (int i = 0; i < arraysize(periods); ++i)
+    periods[i] = -1;
+
+  for (unsigned int i = 0; i < length; ++i) {
+    int funcId;
+
+    CHECK(napi_get_element(env, keys, i, &key));
+    CHECK(napi_get_value_string_utf8(env, key, name, sizeof(name), nullptr));
+    CHECK(napi_get_property(env, object, key, &value));
+    CHECK(napi_typeof(env, value, &valuetype));
+
+    if ((funcId = findUnstableId(name)) < 0) {
+      char errmsg[96] = {0};
+
+      snprintf(errmsg, sizeof(errmsg), "Unknown unstable period '%s'", name);
+      CHECK(createError(env, errmsg, error));
+
+      return false;
+    }
+
+    if (valuetype != napi_number || napi_ok != napi_get_value_int32(env, value, &periods[funcId]) || periods[funcId] < 0) {
+      CHECK(createError(env, "Unstable periods must be non-negative Integers", error));
+      return false;
+    }
+  }
+
+  /* 'ALL' first so the other keys override it */
+  if (periods[TA_FUNC_UNST_ALL] >= 0)
+    settingsSetUnstablePeriod(settings, TA_FUNC_UNST_ALL, (unsigned int)periods[TA_FUNC_UNST_ALL]);
+
+  for (int i = 0; i < TA_FUNC_UNST_ALL; ++i)
+    if (periods[i] >= 0)
+      settingsSetUnstablePeriod(settings, (TA_FuncUnstId)i, (unsigned int)periods[i]);
+
+  return true;
+}
+
+/* Per call 'unstablePeriod' and 'compatibility' on top of the defaults */
+static bool parseSettings(napi_env env, napi_value object, const TaSettings **settings, napi_value *error) {
+  napi_value value;
+  TaSettings custom;
+  int compatibility;
+  bool changed = false;
+
+  *settings = settingsDefault();
+
+  if (!object)
+    return true;
+
+  custom = **settings;
+
+  if (getNamedProperty(env, object, "unstablePeriod", &value)) {
+    if (!parseUnstablePeriods(env, value, &custom, error))
+      return false;
+
+    changed = true;
+  }
+
+  if (getNamedPropertyInt32(env, object, "compatibility", &compatibility)) {
+    if (TA_SUCCESS != settingsSetCompatibility(&custom, (TA_Compatibility)compatibility)) {
+      CHECK(createError(env, "Argument 'compatibility' must be a Compatibility", error));
+      return false;
+    }
+
+    changed = true;
+  }
+
+  if (changed)
+    *settings = settingsIntern(&custom);
+
+  return true;
+}
+
+/* TA_GetLookback counts the unstable periods, so it runs under the call's settings */
+static TA_RetCode getLookback(const TaSettings *settings, const TA_ParamHolder *funcParams, int *lookback) {
+  settingsLoad(settings);
+  return TA_GetLookback(funcParams, lookback);
+}
+
 static napi_value explain(napi_env env, napi_callback_info info) {
   size_t argc = 1;
   napi_value argv, undefined, object, inputs, optInputs, outputs;
@@ -566,7 +1214,13 @@ static napi_value explain(napi_env env, napi_callback_info info) {
   return object;
 }
 
-static void freeWorkData(WorkData *workData) {
+static const TA_InputFlags priceFlags[] = {
+    TA_IN_PRICE_OPEN, TA_IN_PRICE_HIGH, TA_IN_PRICE_LOW,
+    TA_IN_PRICE_CLOSE, TA_IN_PRICE_VOLUME, TA_IN_PRICE_OPENINTEREST,
+};
+static const char *priceNames[] = {"open", "high", "low", "close", "volume", "openInterest"};
+
+static void freeWorkData(napi_env env, WorkData *workData) {
   if (workData->funcParams) {
     TA_ParamHolderFree(workData->funcParams);
     workData->funcParams = nullptr;
@@ -574,163 +1228,332 @@ static void freeWorkData(WorkData *workData) {
 
   if (workData->outReals.size() > 0) {
     for (auto iter = workData->outReals.begin(); iter != workData->outReals.end(); iter++)
-      free(*iter);
+      poolFree(*iter);
 
     workData->outReals.clear();
   }
 
   if (workData->outIntegers.size() > 0) {
     for (auto iter = workData->outIntegers.begin(); iter != workData->outIntegers.end(); iter++)
-      free(*iter);
+      poolFree(*iter);
 
     workData->outIntegers.clear();
   }
 
   if (workData->garbage.size() > 0) {
     for (auto iter = workData->garbage.begin(); iter != workData->garbage.end(); iter++)
-      free(*iter);
+      poolFree(*iter);
 
     workData->garbage.clear();
   }
-}
 
-static bool parseWorkData(napi_env env, napi_value object, WorkData *workData, napi_value *error) {
-  napi_value params;
-  char funcName[64] = {0};
-  double *open = nullptr;
-  double *high = nullptr;
-  double *low = nullptr;
-  double *close = nullptr;
-  double *volume = nullptr;
-  double *openInterest = nullptr;
-  double *inReal;
-  int *inInteger;
-  double optInReal;
-  int optInInteger;
-  double *outReal;
-  int *outInteger;
-  TA_RetCode retCode;
-  const TA_FuncInfo *funcInfo;
-  const TA_InputParameterInfo *inputParaminfo;
-  const TA_OptInputParameterInfo *optParaminfo;
-  const TA_OutputParameterInfo *outputParaminfo;
+  /* References can only be released while the environment is alive */
+  if (env && workData->outArrays.size() > 0) {
+    for (auto iter = workData->outArrays.begin(); iter != workData->outArrays.end(); iter++)
+      if (*iter)
+        CHECK(napi_delete_reference(env, *iter));
 
-  if (!getNamedPropertyString(env, object, "name", funcName, sizeof(funcName))) {
-    CHECK(createError(env, "Missing 'name' field", error));
-    return false;
+    workData->outArrays.clear();
+    workData->outBuffers.clear();
   }
 
-  if (!getNamedPropertyInt32(env, object, "startIdx", &workData->startIdx)) {
-    CHECK(createError(env, "Missing 'startIdx' field", error));
-    return false;
-  }
+  /* The frame can be appended again once no async call reads it */
+  if (env && workData->frame && workData->async)
+    workData->frame->busy--;
 
-  if (!getNamedPropertyInt32(env, object, "endIdx", &workData->endIdx)) {
-    CHECK(createError(env, "Missing 'endIdx' field", error));
-    return false;
-  }
+  workData->frame = nullptr;
 
-  if (workData->startIdx < 0 || workData->endIdx < 0) {
-    CHECK(createError(env, "Arguments 'startIdx' and 'endIdx' need to be positive", error));
-    return false;
-  }
+  if (env && workData->refs.size() > 0) {
+    for (auto iter = workData->refs.begin(); iter != workData->refs.end(); iter++)
+      CHECK(napi_delete_reference(env, *iter));
 
-  if (workData->startIdx > workData->endIdx) {
-    CHECK(createError(env, "Argument 'startIdx' needs to be smaller than argument 'endIdx'", error));
-    return false;
+    workData->refs.clear();
   }
+}
 
-  if (!getNamedProperty(env, object, "params", &params)) {
-    CHECK(createError(env, "Missing 'params' field", error));
-    return false;
-  }
+static bool getNamedPropertyLength(napi_env env, napi_value object, const char *name, size_t *length) {
+  napi_value array;
+  napi_typedarray_type type;
+  unsigned int count;
+  bool isArray;
+  void *data;
 
-  if (TA_SUCCESS != (retCode = TA_GetFuncHandle(funcName, (const TA_FuncHandle **)&workData->funcHandle))) {
-    CHECK(createTAError(env, retCode, error));
+  if (!getNamedProperty(env, object, name, &array))
     return false;
-  }
 
-  if (TA_SUCCESS != (retCode = TA_GetFuncInfo(workData->funcHandle, &funcInfo))) {
-    CHECK(createTAError(env, retCode, error));
-    return false;
-  }
+  if (getTypedArray(env, array, &type, length, &data))
+    return true;
 
-  if (TA_SUCCESS != (retCode = TA_ParamHolderAlloc(workData->funcHandle, &workData->funcParams))) {
-    CHECK(createTAError(env, retCode, error));
-    return false;
-  }
+  CHECK(napi_is_array(env, array, &isArray));
 
-  workData->nbOutput = funcInfo->nbOutput;
+  if (!isArray)
+    return false;
 
-  for (unsigned int i = 0; i < funcInfo->nbInput; ++i) {
-    TA_GetInputParameterInfo(funcInfo->handle, i, &inputParaminfo);
+  CHECK(napi_get_array_length(env, array, &count));
+  *length = count;
+
+  return true;
+}
+
+static bool measureInput(napi_env env, napi_value inputs, const char *name, const WorkData *workData, size_t *inLength, napi_value *error) {
+  size_t length;
+
+  if (!getFrameColumn(env, inputs, name, workData, &length) && !getNamedPropertyLength(env, inputs, name, &length)) {
+    char errmsg[64] = {0};
+
+    snprintf(errmsg, sizeof(errmsg), "Missing '%s' field", name);
+    CHECK(createError(env, errmsg, error));
+
+    return false;
+  }
+
+  *inLength = length < *inLength ? length : *inLength;
+  return true;
+}
+
+/* Sorted by name, filled once with TA_Initialize */
+static std::vector<FuncLayout> funcLayouts;
+
+static void addFuncLayout(const TA_FuncInfo *funcInfo, void *opaque) {
+  FuncLayout layout;
+  const TA_InputParameterInfo *inputParaminfo;
+  const TA_OptInputParameterInfo *optParaminfo;
+  const TA_OutputParameterInfo *outputParaminfo;
+
+  layout.funcHandle = (TA_FuncHandle *)funcInfo->handle;
+  layout.funcInfo = funcInfo;
+  layout.singleFunc = singleFind(funcInfo->name);
+  layout.kernel = kernelFind(funcInfo->name);
+  layout.rolling = rollingFind(funcInfo->name);
+
+  for (unsigned int i = 0; i < funcInfo->nbInput; ++i) {
+    TA_GetInputParameterInfo(funcInfo->handle, i, &inputParaminfo);
+    layout.inputs.push_back(inputParaminfo);
+  }
+
+  for (unsigned int i = 0; i < funcInfo->nbOptInput; ++i) {
+    TA_GetOptInputParameterInfo(funcInfo->handle, i, &optParaminfo);
+    layout.optInputs.push_back(optParaminfo);
+  }
+
+  for (unsigned int i = 0; i < funcInfo->nbOutput; ++i) {
+    TA_GetOutputParameterInfo(funcInfo->handle, i, &outputParaminfo);
+    layout.outputs.push_back(outputParaminfo);
+  }
+
+  funcLayouts.push_back(layout);
+}
+
+static void setupFuncLayouts(void) {
+  TA_ForEachFunc(addFuncLayout, nullptr);
+
+  std::sort(funcLayouts.begin(), funcLayouts.end(), [](const FuncLayout &a, const FuncLayout &b) { return strcmp(a.funcInfo->name, b.funcInfo->name) < 0; });
+}
+
+/* Stands for TA_GetFuncHandle and TA_GetFuncInfo on every call */
+static TA_RetCode getFuncLayout(const char *funcName, const FuncLayout **layout) {
+  auto iter = std::lower_bound(funcLayouts.begin(), funcLayouts.end(), funcName, [](const FuncLayout &a, const char *name) { return strcmp(a.funcInfo->name, name) < 0; });
+
+  if (iter == funcLayouts.end() || strcmp(iter->funcInfo->name, funcName) != 0)
+    return TA_FUNC_NOT_FOUND;
+
+  *layout = &*iter;
+  return TA_SUCCESS;
+}
+
+/* Narrows the run to the last 'tail' outputs, only the lookback window before them is marshalled */
+static bool setupTail(napi_env env, const FuncLayout *layout, napi_value inputs, WorkData *workData, napi_value *error) {
+  size_t inLength = SIZE_MAX;
+  size_t count, begIdx;
+  int lookback;
+  TA_RetCode retCode;
+  const TA_InputParameterInfo *inputParaminfo;
+
+  for (unsigned int i = 0; i < layout->funcInfo->nbInput; ++i) {
+    inputParaminfo = layout->inputs[i];
+
+    if (inputParaminfo->type != TA_Input_Price) {
+      if (!measureInput(env, inputs, inputParaminfo->paramName, workData, &inLength, error))
+        return false;
+
+      continue;
+    }
+
+    for (int j = 0; j < arraysize(priceFlags); ++j)
+      if ((inputParaminfo->flags & priceFlags[j]) && !measureInput(env, inputs, priceNames[j], workData, &inLength, error))
+        return false;
+  }
+
+  if (TA_SUCCESS != (retCode = getLookback(workData->settings, workData->funcParams, &lookback))) {
+    CHECK(createTAError(env, retCode, error));
+    return false;
+  }
+
+  count = (size_t)workData->tail < inLength ? (size_t)workData->tail : inLength;
+  begIdx = inLength - count;
+
+  workData->inOffset = begIdx > (size_t)lookback ? begIdx - lookback : 0;
+  workData->startIdx = (int)(begIdx - workData->inOffset);
+  workData->endIdx = (int)(inLength - workData->inOffset) - 1;
+
+  return true;
+}
+
+static bool checkInputRange(napi_env env, WorkData *workData, napi_value *error) {
+  /* A negative 'endIdx' runs up to the end of the inputs */
+  if (workData->endIdx < 0)
+    workData->endIdx = (int)workData->inLength - 1;
+
+  if (workData->startIdx > workData->endIdx) {
+    CHECK(createError(env, "Argument 'startIdx' needs to be smaller than argument 'endIdx'", error));
+    return false;
+  }
+
+  /* A tail run measured the inputs before reading them, a getter may have shortened one */
+  if (workData->tail > 0 && (size_t)workData->endIdx >= workData->inLength) {
+    CHECK(createError(env, "Inputs need the same length while they are read", error));
+    return false;
+  }
+
+  if ((size_t)workData->endIdx >= workData->inLength) {
+    CHECK(createError(env, "Argument 'endIdx' is out of range of the input arrays", error));
+    return false;
+  }
+
+  return true;
+}
+
+/* Binds the inputs in place when every one of them is a Float32Array */
+static bool setupSingleInputs(napi_env env, const FuncLayout *layout, napi_value inputs, WorkData *workData) {
+  napi_value array;
+  napi_typedarray_type type;
+  size_t length, inLength = workData->inLength;
+  void *data;
+  std::vector<const char *> names;
+  std::vector<napi_value> arrays;
+  const TA_InputParameterInfo *inputParaminfo;
+
+  for (unsigned int i = 0; i < layout->funcInfo->nbInput; ++i) {
+    inputParaminfo = layout->inputs[i];
+
+    if (inputParaminfo->type == TA_Input_Integer)
+      return false;
+
+    if (inputParaminfo->type == TA_Input_Real) {
+      names.push_back(inputParaminfo->paramName);
+      continue;
+    }
+
+    for (int j = 0; j < arraysize(priceFlags); ++j)
+      if (inputParaminfo->flags & priceFlags[j])
+        names.push_back(priceNames[j]);
+  }
+
+  for (size_t i = 0; i < names.size(); ++i) {
+    if (!getNamedProperty(env, inputs, names[i], &array) || !getTypedArray(env, array, &type, &length, &data) || type != napi_float32_array) {
+      workData->singleInputs.clear();
+      return false;
+    }
+
+    if (length < workData->inOffset) {
+      workData->singleInputs.clear();
+      return false;
+    }
+
+    length -= workData->inOffset;
+    inLength = length < inLength ? length : inLength;
+
+    workData->singleInputs.push_back((const float *)data + workData->inOffset);
+    arrays.push_back(array);
+  }
+
+  for (auto iter = arrays.begin(); iter != arrays.end(); iter++)
+    pinValue(env, *iter, workData);
+
+  workData->inLength = inLength;
+  return true;
+}
+
+static bool setupInputs(napi_env env, const FuncLayout *layout, napi_value inputs, WorkData *workData, napi_value *error) {
+  double *open = nullptr;
+  double *high = nullptr;
+  double *low = nullptr;
+  double *close = nullptr;
+  double *volume = nullptr;
+  double *openInterest = nullptr;
+  double *inReal;
+  int *inInteger;
+  TA_RetCode retCode;
+  const TA_InputParameterInfo *inputParaminfo;
+
+  if (workData->tail > 0 && !setupTail(env, layout, inputs, workData, error))
+    return false;
+
+  /* Float32Array inputs run the TA_S_* variant without being widened */
+  if (workData->singleFunc) {
+    if (!workData->frame && setupSingleInputs(env, layout, inputs, workData))
+      return checkInputRange(env, workData, error);
+
+    workData->singleFunc = nullptr;
+  }
+
+  for (unsigned int i = 0; i < layout->funcInfo->nbInput; ++i) {
+    inputParaminfo = layout->inputs[i];
 
     switch (inputParaminfo->type) {
     case TA_Input_Price:
       if (inputParaminfo->flags & TA_IN_PRICE_OPEN) {
-        open = getNamedPropertyDoubleArray(env, params, "open");
+        open = getNamedPropertyDoubleArray(env, inputs, "open", workData);
 
         if (!open) {
           CHECK(createError(env, "Missing 'open' field", error));
           return false;
         }
-
-        workData->garbage.push_back(open);
       }
 
       if (inputParaminfo->flags & TA_IN_PRICE_HIGH) {
-        high = getNamedPropertyDoubleArray(env, params, "high");
+        high = getNamedPropertyDoubleArray(env, inputs, "high", workData);
 
         if (!high) {
           CHECK(createError(env, "Missing 'high' field", error));
           return false;
         }
-
-        workData->garbage.push_back(high);
       }
 
       if (inputParaminfo->flags & TA_IN_PRICE_LOW) {
-        low = getNamedPropertyDoubleArray(env, params, "low");
+        low = getNamedPropertyDoubleArray(env, inputs, "low", workData);
 
         if (!low) {
           CHECK(createError(env, "Missing 'low' field", error));
           return false;
         }
-
-        workData->garbage.push_back(low);
       }
 
       if (inputParaminfo->flags & TA_IN_PRICE_CLOSE) {
-        close = getNamedPropertyDoubleArray(env, params, "close");
+        close = getNamedPropertyDoubleArray(env, inputs, "close", workData);
 
         if (!close) {
           CHECK(createError(env, "Missing 'close' field", error));
           return false;
         }
-
-        workData->garbage.push_back(close);
       }
 
       if (inputParaminfo->flags & TA_IN_PRICE_VOLUME) {
-        volume = getNamedPropertyDoubleArray(env, params, "volume");
+        volume = getNamedPropertyDoubleArray(env, inputs, "volume", workData);
 
         if (!volume) {
           CHECK(createError(env, "Missing 'volume' field", error));
           return false;
         }
-
-        workData->garbage.push_back(volume);
       }
 
       if (inputParaminfo->flags & TA_IN_PRICE_OPENINTEREST) {
-        openInterest = getNamedPropertyDoubleArray(env, params, "openInterest");
+        openInterest = getNamedPropertyDoubleArray(env, inputs, "openInterest", workData);
 
         if (!openInterest) {
           CHECK(createError(env, "Missing 'openInterest' field", error));
           return false;
         }
-
-        workData->garbage.push_back(openInterest);
       }
 
       if (TA_SUCCESS != (retCode = TA_SetInputParamPricePtr(workData->funcParams, i, open, high, low, close, volume, openInterest))) {
@@ -738,10 +1561,18 @@ static bool parseWorkData(napi_env env, napi_value object, WorkData *workData, n
         return false;
       }
 
+      if (workData->kernel || workData->rolling) {
+        const double *prices[] = {open, high, low, close, volume, openInterest};
+
+        for (int j = 0; j < arraysize(prices); ++j)
+          if (prices[j])
+            workData->realInputs.push_back(prices[j]);
+      }
+
       break;
 
     case TA_Input_Real:
-      inReal = getNamedPropertyDoubleArray(env, params, inputParaminfo->paramName);
+      inReal = getNamedPropertyDoubleArray(env, inputs, inputParaminfo->paramName, workData);
 
       if (!inReal) {
         char errmsg[64] = {0};
@@ -752,17 +1583,17 @@ static bool parseWorkData(napi_env env, napi_value object, WorkData *workData, n
         return false;
       }
 
-      workData->garbage.push_back(inReal);
-
       if (TA_SUCCESS != (retCode = TA_SetInputParamRealPtr(workData->funcParams, i, inReal))) {
         CHECK(createTAError(env, retCode, error));
         return false;
       }
 
+      workData->realInputs.push_back(inReal);
+
       break;
 
     case TA_Input_Integer:
-      inInteger = getNamedPropertyInt32Array(env, params, inputParaminfo->paramName);
+      inInteger = getNamedPropertyInt32Array(env, inputs, inputParaminfo->paramName, workData);
 
       if (!inInteger) {
         char errmsg[64] = {0};
@@ -773,25 +1604,35 @@ static bool parseWorkData(napi_env env, napi_value object, WorkData *workData, n
         return false;
       }
 
-      workData->garbage.push_back(inInteger);
-
       if (TA_SUCCESS != (retCode = TA_SetInputParamIntegerPtr(workData->funcParams, i, inInteger))) {
         CHECK(createTAError(env, retCode, error));
         return false;
       }
 
+      workData->kernel = nullptr;
+      workData->rolling = nullptr;
+
       break;
     }
   }
 
-  for (unsigned int i = 0; i < funcInfo->nbOptInput; ++i) {
-    TA_GetOptInputParameterInfo(funcInfo->handle, i, &optParaminfo);
+  return checkInputRange(env, workData, error);
+}
+
+static bool setupOptInputs(napi_env env, const FuncLayout *layout, napi_value optInputs, TA_ParamHolder *funcParams, napi_value *error) {
+  double optInReal;
+  int optInInteger;
+  TA_RetCode retCode;
+  const TA_OptInputParameterInfo *optParaminfo;
+
+  for (unsigned int i = 0; i < layout->funcInfo->nbOptInput; ++i) {
+    optParaminfo = layout->optInputs[i];
 
     switch (optParaminfo->type) {
     case TA_OptInput_RealRange:
     case TA_OptInput_RealList:
-      if (getNamedPropertyDouble(env, params, optParaminfo->paramName, &optInReal)) {
-        if (TA_SUCCESS != (retCode = TA_SetOptInputParamReal(workData->funcParams, i, optInReal))) {
+      if (getNamedPropertyDouble(env, optInputs, optParaminfo->paramName, &optInReal)) {
+        if (TA_SUCCESS != (retCode = TA_SetOptInputParamReal(funcParams, i, optInReal))) {
           CHECK(createTAError(env, retCode, error));
           return false;
         }
@@ -800,8 +1641,8 @@ static bool parseWorkData(napi_env env, napi_value object, WorkData *workData, n
 
     case TA_OptInput_IntegerRange:
     case TA_OptInput_IntegerList:
-      if (getNamedPropertyInt32(env, params, optParaminfo->paramName, &optInInteger)) {
-        if (TA_SUCCESS != (retCode = TA_SetOptInputParamInteger(workData->funcParams, i, optInInteger))) {
+      if (getNamedPropertyInt32(env, optInputs, optParaminfo->paramName, &optInInteger)) {
+        if (TA_SUCCESS != (retCode = TA_SetOptInputParamInteger(funcParams, i, optInInteger))) {
           CHECK(createTAError(env, retCode, error));
           return false;
         }
@@ -810,19 +1651,133 @@ static bool parseWorkData(napi_env env, napi_value object, WorkData *workData, n
     }
   }
 
-  for (unsigned int i = 0; i < funcInfo->nbOutput; ++i) {
-    TA_GetOutputParameterInfo(funcInfo->handle, i, &outputParaminfo);
+  return true;
+}
+
+/* Values of the optional inputs in TA-Lib order, the defaults where missing */
+static void readOptInputs(napi_env env, const FuncLayout *layout, napi_value optInputs, std::vector<double> *values) {
+  double value;
+  const TA_OptInputParameterInfo *optParaminfo;
+
+  values->clear();
+
+  for (unsigned int i = 0; i < layout->funcInfo->nbOptInput; ++i) {
+    optParaminfo = layout->optInputs[i];
+
+    if (!optInputs || !getNamedPropertyDouble(env, optInputs, optParaminfo->paramName, &value))
+      value = optParaminfo->defaultValue;
+
+    values->push_back(value);
+  }
+}
+
+static bool setupOutputOffset(napi_env env, WorkData *workData, napi_value *error) {
+  int lookback;
+  TA_RetCode retCode;
+
+  if (TA_SUCCESS != (retCode = getLookback(workData->settings, workData->funcParams, &lookback))) {
+    CHECK(createTAError(env, retCode, error));
+    return false;
+  }
+
+  /* Aligned buffers cover [startIdx, endIdx], TA-Lib writes from the first valid index */
+  workData->outOffset = lookback > workData->startIdx ? lookback : workData->startIdx;
+  workData->outOffset = workData->outOffset < workData->endIdx ? workData->outOffset : workData->endIdx;
+
+  return true;
+}
+
+/* Binds an aligned output, 'buffer' points at the element for 'startIdx' */
+static bool bindAlignedOutput(napi_env env, WorkData *workData, unsigned int index, TA_OutputParameterType type, void *buffer, napi_value *error) {
+  TA_RetCode retCode;
+
+  workData->outBuffers[index] = buffer;
+
+  if (type == TA_Output_Real)
+    retCode = TA_SetOutputParamRealPtr(workData->funcParams, index, (double *)buffer + (workData->outOffset - workData->startIdx));
+  else
+    retCode = TA_SetOutputParamIntegerPtr(workData->funcParams, index, (int *)buffer + (workData->outOffset - workData->startIdx));
+
+  if (TA_SUCCESS != retCode) {
+    CHECK(createTAError(env, retCode, error));
+    return false;
+  }
+
+  return true;
+}
+
+static bool setupOutputs(napi_env env, const FuncLayout *layout, napi_value outputs, WorkData *workData, napi_value *error) {
+  double *outReal;
+  int *outInteger;
+  napi_value output;
+  napi_valuetype valuetype;
+  bool hasOutputs;
+  TA_RetCode retCode;
+  const TA_OutputParameterInfo *outputParaminfo;
+
+  hasOutputs = outputs != nullptr;
+
+  if (hasOutputs) {
+    CHECK(napi_typeof(env, outputs, &valuetype));
+    hasOutputs = valuetype == napi_object;
+  }
+
+  if (hasOutputs && !setupOutputOffset(env, workData, error))
+    return false;
+
+  workData->outArrays.resize(layout->funcInfo->nbOutput, nullptr);
+  workData->outBuffers.resize(layout->funcInfo->nbOutput, nullptr);
+
+  for (unsigned int i = 0; i < layout->funcInfo->nbOutput; ++i) {
+    outputParaminfo = layout->outputs[i];
+
+    if (hasOutputs && getNamedProperty(env, outputs, outputParaminfo->paramName, &output)) {
+      napi_typedarray_type expected = outputParaminfo->type == TA_Output_Real ? napi_float64_array : napi_int32_array;
+      napi_typedarray_type type;
+      size_t length;
+      void *data;
+
+      if (!getTypedArray(env, output, &type, &length, &data) || type != expected) {
+        char errmsg[64] = {0};
+
+        snprintf(errmsg, sizeof(errmsg), "Output '%s' must be a %s", outputParaminfo->paramName, expected == napi_float64_array ? "Float64Array" : "Int32Array");
+        CHECK(createError(env, errmsg, error));
+
+        return false;
+      }
+
+      if (length <= workData->inOffset + workData->endIdx) {
+        char errmsg[64] = {0};
+
+        snprintf(errmsg, sizeof(errmsg), "Output '%s' is shorter than 'endIdx'", outputParaminfo->paramName);
+        CHECK(createError(env, errmsg, error));
+
+        return false;
+      }
+
+      CHECK(napi_create_reference(env, output, 1, &workData->outArrays[i]));
+
+      /* Caller's buffers are indexed like the inputs */
+      if (outputParaminfo->type == TA_Output_Real)
+        data = (double *)data + workData->inOffset + workData->startIdx;
+      else
+        data = (int *)data + workData->inOffset + workData->startIdx;
+
+      if (!bindAlignedOutput(env, workData, i, outputParaminfo->type, data, error))
+        return false;
+
+      continue;
+    }
 
     switch (outputParaminfo->type) {
     case TA_Output_Real:
-      outReal = (double *)malloc(sizeof(double) * (workData->endIdx - workData->startIdx + 1));
+      outReal = (double *)poolAlloc(sizeof(double) * (workData->endIdx - workData->startIdx + 1));
 
       if (!outReal) {
         CHECK(createError(env, "Out of memory", error));
         return false;
       }
 
-      memset(outReal, 0, sizeof(double) * (workData->endIdx - workData->startIdx + 1));
       workData->outReals.push_back(outReal);
 
       if (TA_SUCCESS != (retCode = TA_SetOutputParamRealPtr(workData->funcParams, i, outReal))) {
@@ -833,14 +1788,13 @@ static bool parseWorkData(napi_env env, napi_value object, WorkData *workData, n
       break;
 
     case TA_Output_Integer:
-      outInteger = (int *)malloc(sizeof(int) * (workData->endIdx - workData->startIdx + 1));
+      outInteger = (int *)poolAlloc(sizeof(int) * (workData->endIdx - workData->startIdx + 1));
 
       if (!outInteger) {
         CHECK(createError(env, "Out of memory", error));
         return false;
       }
 
-      memset(outInteger, 0, sizeof(int) * (workData->endIdx - workData->startIdx + 1));
       workData->outIntegers.push_back(outInteger);
 
       if (TA_SUCCESS != (retCode = TA_SetOutputParamIntegerPtr(workData->funcParams, i, outInteger))) {
@@ -855,172 +1809,4329 @@ static bool parseWorkData(napi_env env, napi_value object, WorkData *workData, n
   return true;
 }
 
-static bool generateResult(napi_env env, const WorkData *workData, napi_value *result) {
-  napi_value object, array;
-  int outRealIdx = 0;
-  int outIntegerIdx = 0;
-  double *outReal;
-  int *outInteger;
-  const TA_OutputParameterInfo *outputParaminfo;
+static bool setupWorkData(napi_env env, const char *funcName, napi_value inputs, napi_value optInputs, napi_value outputs, WorkData *workData, napi_value *error) {
+  TA_RetCode retCode;
+  const FuncLayout *layout;
 
-  if (TA_SUCCESS != workData->retCode) {
-    CHECK(createTAError(env, workData->retCode, result));
+  if (TA_SUCCESS != (retCode = getFuncLayout(funcName, &layout))) {
+    CHECK(createTAError(env, retCode, error));
     return false;
   }
 
-  CHECK(napi_create_object(env, result));
-  CHECK(napi_create_object(env, &object));
-
-  CHECK(setNamedPropertyInt32(env, *result, "begIndex", workData->outBegIdx));
-  CHECK(setNamedPropertyInt32(env, *result, "nbElement", workData->outNBElement));
+  workData->funcHandle = layout->funcHandle;
 
-  for (unsigned int i = 0; i < workData->nbOutput; ++i) {
-    TA_GetOutputParameterInfo(workData->funcHandle, i, &outputParaminfo);
+  if (TA_SUCCESS != (retCode = TA_ParamHolderAlloc(workData->funcHandle, &workData->funcParams))) {
+    CHECK(createTAError(env, retCode, error));
+    return false;
+  }
 
-    CHECK(napi_create_array_with_length(env, workData->outNBElement, &array));
+  workData->nbOutput = layout->funcInfo->nbOutput;
 
-    switch (outputParaminfo->type) {
-    case TA_Output_Real:
-      outReal = workData->outReals[outRealIdx++];
+  /* Optional inputs go first, the tail window depends on the lookback */
+  if (optInputs && !setupOptInputs(env, layout, optInputs, workData->funcParams, error))
+    return false;
 
-      for (int j = 0; j < workData->outNBElement; ++j)
-        CHECK(setArrayDouble(env, array, j, outReal[j]));
+  /* Only a candidate, setupInputs drops it unless every input is a Float32Array */
+  workData->singleFunc = layout->singleFunc;
+  workData->kernel = layout->kernel;
+  workData->rolling = layout->rolling;
 
-      break;
+  if (workData->singleFunc || workData->rolling)
+    readOptInputs(env, layout, optInputs, &workData->optInputs);
 
-    case TA_Output_Integer:
-      outInteger = workData->outIntegers[outIntegerIdx++];
+  if (!setupInputs(env, layout, inputs, workData, error))
+    return false;
 
-      for (int j = 0; j < workData->outNBElement; ++j)
-        CHECK(setArrayInt32(env, array, j, outInteger[j]));
+  return setupOutputs(env, layout, outputs, workData, error);
+}
 
-      break;
-    }
+static FrameData *getFrameData(napi_env env, napi_value value) {
+  napi_value constructor;
+  napi_valuetype valuetype;
+  AddonData *addonData;
+  FrameData *frameData;
+  bool isFrame;
 
-    CHECK(napi_set_named_property(env, object, outputParaminfo->paramName, array));
-  }
+  CHECK(napi_typeof(env, value, &valuetype));
 
-  CHECK(napi_set_named_property(env, *result, "results", object));
+  if (valuetype != napi_object)
+    return nullptr;
 
-  return true;
-}
+  CHECK(napi_get_instance_data(env, (void **)&addonData));
+  CHECK(napi_get_reference_value(env, addonData->frameConstructor, &constructor));
+  CHECK(napi_instanceof(env, value, constructor, &isFrame));
 
-static napi_value executeSync(napi_env env, napi_value object) {
-  napi_value result, undefined, error;
-  WorkData workData;
+  if (!isFrame || napi_ok != napi_unwrap(env, value, (void **)&frameData))
+    return nullptr;
 
-  CHECK(napi_get_undefined(env, &undefined));
+  return frameData;
+}
 
-  if (!parseWorkData(env, object, &workData, &error)) {
-    freeWorkData(&workData);
-    CHECK(napi_throw(env, error));
-    return undefined;
+static bool bindFrame(napi_env env, napi_value value, WorkData *workData, napi_value *error) {
+  if (!(workData->frame = getFrameData(env, value))) {
+    CHECK(createError(env, "Field 'frame' must be a Frame", error));
+    return false;
   }
 
-  workData.retCode = TA_CallFunc(workData.funcParams, workData.startIdx, workData.endIdx, &workData.outBegIdx, &workData.outNBElement);
-
-  if (!generateResult(env, &workData, &result)) {
-    freeWorkData(&workData);
-    CHECK(napi_throw(env, result));
-    return undefined;
+  /* Async calls keep the frame alive and its columns in place */
+  if (workData->async) {
+    workData->frame->busy++;
+    pinValue(env, value, workData);
   }
 
-  freeWorkData(&workData);
-  return result;
+  return true;
+}
+
+static bool parseWorkData(napi_env env, napi_value object, WorkData *workData, napi_value *error) {
+  napi_value params, outputs, frame;
+  char funcName[64] = {0};
+
+  if (!getNamedPropertyString(env, object, "name", funcName, sizeof(funcName))) {
+    CHECK(createError(env, "Missing 'name' field", error));
+    return false;
+  }
+
+  /* 'tail' replaces 'startIdx' and 'endIdx' with the last N outputs */
+  if (getNamedPropertyInt32(env, object, "tail", &workData->tail)) {
+    if (workData->tail <= 0) {
+      CHECK(createError(env, "Argument 'tail' needs to be positive", error));
+      return false;
+    }
+
+    /* Each tail run marshals its own window */
+    workData->inputCache = nullptr;
+  } else {
+    if (!getNamedPropertyInt32(env, object, "startIdx", &workData->startIdx)) {
+      CHECK(createError(env, "Missing 'startIdx' field", error));
+      return false;
+    }
+
+    if (!getNamedPropertyInt32(env, object, "endIdx", &workData->endIdx)) {
+      CHECK(createError(env, "Missing 'endIdx' field", error));
+      return false;
+    }
+
+    if (workData->startIdx < 0 || workData->endIdx < 0) {
+      CHECK(createError(env, "Arguments 'startIdx' and 'endIdx' need to be positive", error));
+      return false;
+    }
+
+    if (workData->startIdx > workData->endIdx) {
+      CHECK(createError(env, "Argument 'startIdx' needs to be smaller than argument 'endIdx'", error));
+      return false;
+    }
+  }
+
+  if (getNamedProperty(env, object, "frame", &frame)) {
+    if (!bindFrame(env, frame, workData, error))
+      return false;
+
+    /* Frame columns are read in place, the batch cache is not needed */
+    workData->inputCache = nullptr;
+  }
+
+  if (!getNamedProperty(env, object, "params", &params)) {
+    if (!workData->frame) {
+      CHECK(createError(env, "Missing 'params' field", error));
+      return false;
+    }
+
+    params = frame;
+  }
+
+  getNamedPropertyBool(env, object, "typed", &workData->typed);
+  getNamedPropertyBool(env, object, "profile", &workData->profile);
+
+  if (!parseSettings(env, object, &workData->settings, error))
+    return false;
+
+  if (!getNamedProperty(env, object, "outputs", &outputs))
+    outputs = nullptr;
+
+  return setupWorkData(env, funcName, params, params, outputs, workData, error);
+}
+
+static void finalizeExternalArray(napi_env env, void *data, void *hint) {
+  int64_t adjustedValue;
+
+  CHECK(napi_adjust_external_memory(env, -(int64_t)(size_t)hint, &adjustedValue));
+  poolFree(data);
+}
+
+/* The typed array views 'length' elements from 'byteOffset' of the whole buffer */
+static bool createExternalTypedArray(napi_env env, napi_typedarray_type type, void *data, size_t size, size_t byteOffset, size_t length, napi_value *array) {
+  napi_value arraybuffer;
+  int64_t adjustedValue;
+
+  /* Some runtimes (e.g. Electron) do not allow external buffers */
+  if (napi_ok != napi_create_external_arraybuffer(env, data, size, finalizeExternalArray, (void *)size, &arraybuffer))
+    return false;
+
+  CHECK(napi_adjust_external_memory(env, (int64_t)size, &adjustedValue));
+  CHECK(napi_create_typedarray(env, type, length, arraybuffer, byteOffset, array));
+
+  return true;
+}
+
+static void createCopiedTypedArray(napi_env env, napi_typedarray_type type, const void *data, size_t size, size_t length, napi_value *array) {
+  napi_value arraybuffer;
+  void *buffer;
+
+  CHECK(napi_create_arraybuffer(env, size, &buffer, &arraybuffer));
+
+  if (size > 0)
+    memcpy(buffer, data, size);
+
+  CHECK(napi_create_typedarray(env, type, length, arraybuffer, 0, array));
+}
+
+static void recordStats(const WorkData *workData) {
+  const TA_FuncInfo *funcInfo;
+  StatsSample sample;
+
+  if (!statsEnabled())
+    return;
+
+  TA_GetFuncInfo(workData->funcHandle, &funcInfo);
+
+  sample.elements = workData->endIdx - workData->startIdx + 1;
+  sample.inputBytes = (int64_t)workData->inputBytes;
+  sample.parseTime = workData->parseTime;
+  sample.computeTime = workData->computeTime;
+  sample.marshalTime = workData->marshalTime;
+  sample.queueTime = workData->queueTime;
+
+  statsRecord(funcInfo->name, &sample);
+}
+
+static bool generateResult(napi_env env, WorkData *workData, napi_value *result) {
+  napi_value object, array;
+  int outRealIdx = 0;
+  int outIntegerIdx = 0;
+  double *outReal;
+  int *outInteger;
+  size_t outSize = workData->endIdx - workData->startIdx + 1;
+  const TA_OutputParameterInfo *outputParaminfo;
+  int64_t startedAt = now();
+
+  if (TA_SUCCESS != workData->retCode) {
+    CHECK(createTAError(env, workData->retCode, result));
+    return false;
+  }
+
+  CHECK(napi_create_object(env, result));
+  CHECK(napi_create_object(env, &object));
+
+  CHECK(setNamedPropertyInt32(env, *result, "begIndex", (int)workData->inOffset + workData->outBegIdx));
+  CHECK(setNamedPropertyInt32(env, *result, "nbElement", workData->outNBElement));
+
+  for (unsigned int i = 0; i < workData->nbOutput; ++i) {
+    TA_GetOutputParameterInfo(workData->funcHandle, i, &outputParaminfo);
+
+    if (workData->outArrays[i]) {
+      CHECK(napi_get_reference_value(env, workData->outArrays[i], &array));
+      CHECK(napi_set_named_property(env, object, outputParaminfo->paramName, array));
+      continue;
+    }
+
+    switch (outputParaminfo->type) {
+    case TA_Output_Real:
+      outReal = workData->outReals[outRealIdx++];
+
+      if (workData->typed) {
+        /* The result takes over the buffer, it is freed by the finalizer */
+        if (createExternalTypedArray(env, napi_float64_array, outReal, sizeof(double) * outSize, 0, workData->outNBElement, &array))
+          workData->outReals[outRealIdx - 1] = nullptr;
+        else
+          createCopiedTypedArray(env, napi_float64_array, outReal, sizeof(double) * workData->outNBElement, workData->outNBElement, &array);
+
+        break;
+      }
+
+      CHECK(napi_create_array_with_length(env, workData->outNBElement, &array));
+
+      /* Every element fails once a Worker is terminated, the first failure is enough */
+      for (int j = 0; j < workData->outNBElement; ++j) {
+        napi_status status = setArrayDouble(env, array, j, outReal[j]);
+
+        if (napi_ok != status) {
+          CHECK(status);
+          break;
+        }
+      }
+
+      break;
+
+    case TA_Output_Integer:
+      outInteger = workData->outIntegers[outIntegerIdx++];
+
+      if (workData->typed) {
+        if (createExternalTypedArray(env, napi_int32_array, outInteger, sizeof(int) * outSize, 0, workData->outNBElement, &array))
+          workData->outIntegers[outIntegerIdx - 1] = nullptr;
+        else
+          createCopiedTypedArray(env, napi_int32_array, outInteger, sizeof(int) * workData->outNBElement, workData->outNBElement, &array);
+
+        break;
+      }
+
+      CHECK(napi_create_array_with_length(env, workData->outNBElement, &array));
+
+      /* Every element fails once a Worker is terminated, the first failure is enough */
+      for (int j = 0; j < workData->outNBElement; ++j) {
+        napi_status status = setArrayInt32(env, array, j, outInteger[j]);
+
+        if (napi_ok != status) {
+          CHECK(status);
+          break;
+        }
+      }
+
+      break;
+    }
+
+    CHECK(napi_set_named_property(env, object, outputParaminfo->paramName, array));
+  }
+
+  CHECK(napi_set_named_property(env, *result, "results", object));
+
+  workData->marshalTime = now() - startedAt;
+  recordStats(workData);
+
+  return true;
+}
+
+/* 'buffer' holds the elements from 'startIdx' to 'endIdx' */
+template <typename T>
+static void alignOutput(const WorkData *workData, T *buffer, T blank) {
+  int begIdx = (workData->outNBElement > 0 ? workData->outBegIdx : workData->endIdx + 1) - workData->startIdx;
+  int outOffset = workData->outOffset - workData->startIdx;
+  int size = workData->endIdx - workData->startIdx + 1;
+
+  if (workData->outNBElement > 0 && begIdx != outOffset)
+    memmove(buffer + begIdx, buffer + outOffset, sizeof(T) * workData->outNBElement);
+
+  for (int i = 0; i < begIdx; ++i)
+    buffer[i] = blank;
+
+  for (int i = begIdx + workData->outNBElement; i < size; ++i)
+    buffer[i] = blank;
+}
+
+/* Same buffers as bound to the ParamHolder */
+static void getOutputs(const WorkData *workData, std::vector<void *> *outputs) {
+  size_t outRealIdx = 0, outIntegerIdx = 0;
+  const TA_OutputParameterInfo *outputParaminfo;
+
+  outputs->resize(workData->nbOutput);
+
+  for (unsigned int i = 0; i < workData->nbOutput; ++i) {
+    TA_GetOutputParameterInfo(workData->funcHandle, i, &outputParaminfo);
+
+    if (outputParaminfo->type == TA_Output_Real) {
+      if (workData->outBuffers[i])
+        (*outputs)[i] = (double *)workData->outBuffers[i] + (workData->outOffset - workData->startIdx);
+      else
+        (*outputs)[i] = workData->outReals[outRealIdx++];
+    } else {
+      if (workData->outBuffers[i])
+        (*outputs)[i] = (int *)workData->outBuffers[i] + (workData->outOffset - workData->startIdx);
+      else
+        (*outputs)[i] = workData->outIntegers[outIntegerIdx++];
+    }
+  }
+}
+
+static TA_RetCode callSingleFunc(WorkData *workData) {
+  std::vector<void *> outputs;
+  std::vector<double *> outReals;
+
+  /* The single functions only have real outputs */
+  getOutputs(workData, &outputs);
+
+  for (auto iter = outputs.begin(); iter != outputs.end(); iter++)
+    outReals.push_back((double *)*iter);
+
+  return workData->singleFunc(workData->startIdx, workData->endIdx, workData->singleInputs.data(), workData->optInputs.data(), &workData->outBegIdx, &workData->outNBElement, outReals.data());
+}
+
+/* Kernels have no lookback, every element from 'startIdx' is written */
+static TA_RetCode callKernel(WorkData *workData) {
+  std::vector<const double *> inputs(workData->realInputs.size());
+  std::vector<void *> outputs;
+
+  if (workData->startIdx < 0)
+    return TA_OUT_OF_RANGE_START_INDEX;
+
+  if (workData->endIdx < workData->startIdx)
+    return TA_OUT_OF_RANGE_END_INDEX;
+
+  for (size_t i = 0; i < inputs.size(); ++i)
+    inputs[i] = workData->realInputs[i] + workData->startIdx;
+
+  getOutputs(workData, &outputs);
+
+  workData->outBegIdx = workData->startIdx;
+  workData->outNBElement = workData->endIdx - workData->startIdx + 1;
+  workData->kernel(inputs.data(), (double *)outputs[0], workData->outNBElement);
+
+  return TA_SUCCESS;
+}
+
+static TA_RetCode callRolling(WorkData *workData) {
+  std::vector<void *> outputs;
+
+  if (!workData->rolling)
+    return TA_NOT_SUPPORTED;
+
+  getOutputs(workData, &outputs);
+
+  return workData->rolling(workData->startIdx, workData->endIdx, workData->realInputs.data(), workData->optInputs.data(), &workData->outBegIdx, &workData->outNBElement, outputs.data());
+}
+
+static void executeWorkData(WorkData *workData) {
+  const TA_OutputParameterInfo *outputParaminfo;
+  int64_t startedAt = now();
+
+  settingsLoad(workData->settings);
+
+  if (workData->singleFunc)
+    workData->retCode = callSingleFunc(workData);
+  else if (workData->kernel)
+    workData->retCode = callKernel(workData);
+  else
+    workData->retCode = callRolling(workData);
+
+  /* No native path, or a rolling function left inputs holding NaN to TA-Lib */
+  if (TA_NOT_SUPPORTED == workData->retCode)
+    workData->retCode = TA_CallFunc(workData->funcParams, workData->startIdx, workData->endIdx, &workData->outBegIdx, &workData->outNBElement);
+
+  if (TA_SUCCESS != workData->retCode) {
+    workData->computeTime = now() - startedAt;
+    return;
+  }
+
+  for (unsigned int i = 0; i < workData->nbOutput; ++i) {
+    if (!workData->outBuffers[i])
+      continue;
+
+    TA_GetOutputParameterInfo(workData->funcHandle, i, &outputParaminfo);
+
+    if (outputParaminfo->type == TA_Output_Real)
+      alignOutput(workData, (double *)workData->outBuffers[i], (double)NAN);
+    else
+      alignOutput(workData, (int *)workData->outBuffers[i], 0);
+  }
+
+  workData->computeTime = now() - startedAt;
+}
+
+static void runAsyncTask(void *data, int index) {
+  AsyncTask *task = (AsyncTask *)data;
+  AddonData *addonData = task->addonData;
+
+  task->queueTime = now() - task->queuedAt;
+
+  /* Aborted while queued, the job is dropped without running */
+  if (!task->aborted.load(std::memory_order_relaxed))
+    task->execute(task->data);
+
+  /* Fails only while the environment is shutting down */
+  napi_call_threadsafe_function(addonData->tsfn, task, napi_tsfn_nonblocking);
+
+  std::lock_guard<std::mutex> lock(addonData->mutex);
+
+  if (--addonData->running == 0)
+    addonData->idle.notify_all();
+}
+
+/* False once a terminating Worker stopped running JavaScript */
+static bool canCallIntoJS(napi_env env) {
+  napi_value global, value;
+
+  return napi_ok == napi_get_global(env, &global) && napi_ok == napi_get_named_property(env, global, "undefined", &value);
+}
+
+static void completeAsyncTask(napi_env env, napi_value js_callback, void *context, void *data) {
+  AddonData *addonData = (AddonData *)context;
+  AsyncTask *task = (AsyncTask *)data;
+
+  /* Results can no longer be delivered, only the native memory is released */
+  if (env && !canCallIntoJS(env)) {
+    task->complete(nullptr, task->data);
+    return;
+  }
+
+  task->complete(env, task->data);
+
+  /* Keep the event loop alive only while tasks are in flight */
+  if (env && --addonData->pending == 0)
+    CHECK(napi_unref_threadsafe_function(env, addonData->tsfn));
+}
+
+static void queueAsyncTask(napi_env env, AsyncTask *task) {
+  AddonData *addonData;
+
+  CHECK(napi_get_instance_data(env, (void **)&addonData));
+
+  if (addonData->pending++ == 0)
+    CHECK(napi_ref_threadsafe_function(env, addonData->tsfn));
+
+  addonData->mutex.lock();
+  addonData->running += 1;
+  addonData->mutex.unlock();
+
+  task->addonData = addonData;
+  task->queuedAt = now();
+  executorSubmit(runAsyncTask, task);
+}
+
+static napi_value abortAsyncTask(napi_env env, napi_callback_info info) {
+  AsyncTask *task;
+
+  CHECK(napi_get_cb_info(env, info, nullptr, nullptr, nullptr, (void **)&task));
+
+  task->aborted.store(true, std::memory_order_relaxed);
+
+  return nullptr;
+}
+
+static bool callSignalMethod(napi_env env, napi_value signal, const char *method, napi_value listener) {
+  napi_value function, argv[2];
+  napi_valuetype valuetype;
+
+  CHECK(napi_get_named_property(env, signal, method, &function));
+  CHECK(napi_typeof(env, function, &valuetype));
+
+  if (valuetype != napi_function)
+    return false;
+
+  CHECK(napi_create_string_utf8(env, "abort", NAPI_AUTO_LENGTH, &argv[0]));
+  argv[1] = listener;
+
+  return napi_ok == napi_call_function(env, signal, function, 2, argv, nullptr);
+}
+
+/* Follow options.signal, false with the abort reason if it is already aborted */
+static bool watchSignal(napi_env env, napi_value options, AsyncTask *task, napi_value *error) {
+  napi_value signal, listener;
+  napi_valuetype valuetype;
+  bool aborted = false;
+
+  if (!options || !getNamedProperty(env, options, "signal", &signal))
+    return true;
+
+  CHECK(napi_typeof(env, signal, &valuetype));
+
+  if (valuetype != napi_object) {
+    CHECK(createError(env, "Option 'signal' must be a AbortSignal", error));
+    return false;
+  }
+
+  getNamedPropertyBool(env, signal, "aborted", &aborted);
+
+  if (aborted) {
+    CHECK(napi_get_named_property(env, signal, "reason", error));
+    return false;
+  }
+
+  CHECK(napi_create_function(env, "abort", NAPI_AUTO_LENGTH, abortAsyncTask, task, &listener));
+
+  if (!callSignalMethod(env, signal, "addEventListener", listener)) {
+    CHECK(createError(env, "Option 'signal' must be a AbortSignal", error));
+    return false;
+  }
+
+  CHECK(napi_create_reference(env, signal, 1, &task->signal));
+  CHECK(napi_create_reference(env, listener, 1, &task->listener));
+
+  return true;
+}
+
+/* Deliver error or result, an aborted promise is rejected with the abort reason */
+static void settleAsyncTask(napi_env env, AsyncTask *task, napi_ref cbref, napi_value error, napi_value result) {
+  napi_value undefined, signal, listener, callback, argv[2];
+
+  CHECK(napi_get_undefined(env, &undefined));
+
+  if (task->signal) {
+    CHECK(napi_get_reference_value(env, task->signal, &signal));
+    CHECK(napi_get_reference_value(env, task->listener, &listener));
+
+    if (task->aborted.load(std::memory_order_relaxed))
+      CHECK(napi_get_named_property(env, signal, "reason", &error));
+
+    callSignalMethod(env, signal, "removeEventListener", listener);
+
+    CHECK(napi_delete_reference(env, task->signal));
+    CHECK(napi_delete_reference(env, task->listener));
+
+    task->signal = task->listener = nullptr;
+  }
+
+  if (task->deferred) {
+    if (error)
+      CHECK(napi_reject_deferred(env, task->deferred, error));
+    else
+      CHECK(napi_resolve_deferred(env, task->deferred, result));
+
+    task->deferred = nullptr;
+    return;
+  }
+
+  argv[0] = error ? error : undefined;
+  argv[1] = error ? undefined : result;
+
+  CHECK(napi_get_reference_value(env, cbref, &callback));
+  CHECK(napi_call_function(env, undefined, callback, 2, argv, nullptr));
+  CHECK(napi_delete_reference(env, cbref));
+}
+
+/* Phase times of a 'profile' call in microseconds, the result is complete by then */
+static void setTimings(napi_env env, const WorkData *workData, napi_value result) {
+  napi_value timings;
+
+  CHECK(napi_create_object(env, &timings));
+
+  CHECK(setNamedPropertyDouble(env, timings, "parse", workData->parseTime / 1000.0));
+  CHECK(setNamedPropertyDouble(env, timings, "compute", workData->computeTime / 1000.0));
+  CHECK(setNamedPropertyDouble(env, timings, "marshal", workData->marshalTime / 1000.0));
+
+  CHECK(napi_set_named_property(env, result, "timings", timings));
+}
+
+static napi_value executeSync(napi_env env, napi_value object) {
+  napi_value result, undefined, error;
+  WorkData workData;
+  int64_t startedAt = now();
+
+  CHECK(napi_get_undefined(env, &undefined));
+
+  if (!parseWorkData(env, object, &workData, &error)) {
+    freeWorkData(env, &workData);
+    CHECK(napi_throw(env, error));
+    return undefined;
+  }
+
+  workData.parseTime = now() - startedAt;
+
+  executeWorkData(&workData);
+
+  if (!generateResult(env, &workData, &result)) {
+    freeWorkData(env, &workData);
+    CHECK(napi_throw(env, result));
+    return undefined;
+  }
+
+  if (workData.profile)
+    setTimings(env, &workData, result);
+
+  freeWorkData(env, &workData);
+  return result;
+}
+
+static void executeAsyncCallback(void *data) {
+  AsyncWorkData *asyncWorkData = (AsyncWorkData *)data;
+
+  executeWorkData(&asyncWorkData->workData);
+}
+
+static void executeAsyncComplete(napi_env env, void *data) {
+  AsyncWorkData *asyncWorkData = (AsyncWorkData *)data;
+  napi_value error = nullptr, result = nullptr;
+
+  if (env && !asyncWorkData->task.aborted) {
+    asyncWorkData->workData.queueTime = asyncWorkData->task.queueTime;
+
+    if (!generateResult(env, &asyncWorkData->workData, &result))
+      error = result;
+    else if (asyncWorkData->workData.profile)
+      setTimings(env, &asyncWorkData->workData, result);
+  }
+
+  /* Released before the callback, which may append to a frame read by the call */
+  freeWorkData(env, &asyncWorkData->workData);
+
+  if (env)
+    settleAsyncTask(env, &asyncWorkData->task, asyncWorkData->cbref, error, result);
+
+  delete asyncWorkData;
+}
+
+/* Errors are passed to the callback, or reject the promise returned without one */
+static napi_value failAsyncCall(napi_env env, napi_value callback, napi_deferred deferred, napi_value promise, napi_value error) {
+  napi_value undefined, argv[2];
+
+  CHECK(napi_get_undefined(env, &undefined));
+
+  if (deferred) {
+    CHECK(napi_reject_deferred(env, deferred, error));
+    return promise;
+  }
+
+  argv[0] = error;
+  argv[1] = undefined;
+
+  CHECK(napi_call_function(env, undefined, callback, 2, argv, nullptr));
+  return undefined;
+}
+
+static napi_value executeAsync(napi_env env, napi_value object, napi_value callback, napi_value options) {
+  napi_value undefined, promise, error;
+  AsyncWorkData *asyncWorkData = new AsyncWorkData();
+  int64_t startedAt = now();
+
+  CHECK(napi_get_undefined(env, &undefined));
+
+  if (!asyncWorkData) {
+    napi_throw_type_error(env, nullptr, "Out of memory");
+    return undefined;
+  }
+
+  promise = undefined;
+
+  if (!callback)
+    CHECK(napi_create_promise(env, &asyncWorkData->task.deferred, &promise));
+
+  asyncWorkData->workData.async = true;
+
+  if (!parseWorkData(env, object, &asyncWorkData->workData, &error) ||
+      !watchSignal(env, options, &asyncWorkData->task, &error)) {
+    napi_deferred deferred = asyncWorkData->task.deferred;
+
+    freeWorkData(env, &asyncWorkData->workData);
+    delete asyncWorkData;
+
+    return failAsyncCall(env, callback, deferred, promise, error);
+  }
+
+  asyncWorkData->workData.parseTime = now() - startedAt;
+
+  asyncWorkData->task.execute = executeAsyncCallback;
+  asyncWorkData->task.complete = executeAsyncComplete;
+  asyncWorkData->task.data = asyncWorkData;
+
+  if (callback)
+    CHECK(napi_create_reference(env, callback, 1, &asyncWorkData->cbref));
+
+  queueAsyncTask(env, &asyncWorkData->task);
+
+  return promise;
+}
+
+static napi_value execute(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2], undefined;
+  napi_valuetype valuetype;
+
+  CHECK(napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+  CHECK(napi_get_undefined(env, &undefined));
+
+  CHECK(napi_typeof(env, argv[0], &valuetype));
+
+  if (valuetype != napi_object) {
+    napi_throw_type_error(env, nullptr, "The first argument must be a Object");
+    return undefined;
+  }
+
+  CHECK(napi_typeof(env, argv[1], &valuetype));
+
+  return valuetype == napi_function
+             ? executeAsync(env, argv[0], argv[1], nullptr)
+             : executeSync(env, argv[0]);
+}
+
+static napi_value executePromise(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2], undefined;
+  napi_valuetype valuetype;
+
+  CHECK(napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+  CHECK(napi_get_undefined(env, &undefined));
+
+  CHECK(napi_typeof(env, argv[0], &valuetype));
+
+  if (valuetype != napi_object) {
+    napi_throw_type_error(env, nullptr, "The first argument must be a Object");
+    return undefined;
+  }
+
+  CHECK(napi_typeof(env, argv[1], &valuetype));
+
+  return executeAsync(env, argv[0], nullptr, valuetype == napi_object ? argv[1] : nullptr);
+}
+
+static void freeBatchWorkData(napi_env env, BatchWorkData *batchWorkData) {
+  for (auto iter = batchWorkData->jobs.begin(); iter != batchWorkData->jobs.end(); iter++)
+    freeWorkData(env, &*iter);
+
+  if (batchWorkData->sweep) {
+    for (auto iter = batchWorkData->sweep->matrices.begin(); iter != batchWorkData->sweep->matrices.end(); iter++)
+      poolFree(*iter);
+
+    delete batchWorkData->sweep;
+    batchWorkData->sweep = nullptr;
+  }
+
+  batchWorkData->jobs.clear();
+}
+
+static bool parseBatchWorkData(napi_env env, napi_value array, bool async, BatchWorkData *batchWorkData, napi_value *error) {
+  napi_value object;
+  napi_valuetype valuetype;
+  unsigned int length;
+
+  CHECK(napi_get_array_length(env, array, &length));
+
+  batchWorkData->jobs.resize(length);
+
+  for (unsigned int i = 0; i < length; ++i) {
+    WorkData *workData = &batchWorkData->jobs[i];
+
+    CHECK(napi_get_element(env, array, i, &object));
+    CHECK(napi_typeof(env, object, &valuetype));
+
+    if (valuetype != napi_object) {
+      CHECK(createError(env, "Each job must be a Object", error));
+      return false;
+    }
+
+    /* Jobs marshal each distinct input array only once */
+    workData->async = async;
+    workData->inputCache = &batchWorkData->inputCache;
+    workData->parseTime = now();
+
+    if (!parseWorkData(env, object, workData, error))
+      return false;
+
+    workData->parseTime = now() - workData->parseTime;
+  }
+
+  /* The cached napi_values are only valid during this call */
+  batchWorkData->inputCache.arrays.clear();
+
+  return true;
+}
+
+static void executeBatchJob(void *data, int index) {
+  BatchWorkData *batchWorkData = (BatchWorkData *)data;
+
+  /* Jobs not started when the call is aborted are skipped */
+  if (batchWorkData->task.aborted.load(std::memory_order_relaxed))
+    return;
+
+  executeWorkData(&batchWorkData->jobs[index]);
+}
+
+static void executeBatchWorkData(BatchWorkData *batchWorkData) {
+  int count = (int)batchWorkData->jobs.size();
+
+  if (batchWorkData->parallel) {
+    executorParallelFor(count, 1, executeBatchJob, batchWorkData);
+    return;
+  }
+
+  for (int i = 0; i < count; ++i)
+    executeBatchJob(batchWorkData, i);
+}
+
+static bool generateSweepResult(napi_env env, BatchWorkData *batchWorkData, napi_value *result);
+
+static bool generateBatchResult(napi_env env, BatchWorkData *batchWorkData, napi_value *result) {
+  napi_value array, value;
+
+  if (batchWorkData->sweep)
+    return generateSweepResult(env, batchWorkData, result);
+
+  CHECK(napi_create_array_with_length(env, batchWorkData->jobs.size(), &array));
+
+  for (size_t i = 0; i < batchWorkData->jobs.size(); ++i) {
+    if (!generateResult(env, &batchWorkData->jobs[i], &value)) {
+      *result = value;
+      return false;
+    }
+
+    CHECK(napi_set_element(env, array, (uint32_t)i, value));
+  }
+
+  *result = array;
+  return true;
+}
+
+static napi_value executeBatchSync(napi_env env, napi_value array, bool parallel) {
+  napi_value result, undefined, error;
+  BatchWorkData batchWorkData;
+
+  CHECK(napi_get_undefined(env, &undefined));
+
+  batchWorkData.parallel = parallel;
+
+  if (!parseBatchWorkData(env, array, false, &batchWorkData, &error)) {
+    freeBatchWorkData(env, &batchWorkData);
+    CHECK(napi_throw(env, error));
+    return undefined;
+  }
+
+  executeBatchWorkData(&batchWorkData);
+
+  if (!generateBatchResult(env, &batchWorkData, &result)) {
+    freeBatchWorkData(env, &batchWorkData);
+    CHECK(napi_throw(env, result));
+    return undefined;
+  }
+
+  freeBatchWorkData(env, &batchWorkData);
+  return result;
+}
+
+static void executeBatchAsyncCallback(void *data) {
+  executeBatchWorkData((BatchWorkData *)data);
+}
+
+static void executeBatchAsyncComplete(napi_env env, void *data) {
+  BatchWorkData *batchWorkData = (BatchWorkData *)data;
+  napi_value error = nullptr, result = nullptr;
+
+  if (env && !batchWorkData->task.aborted) {
+    for (auto iter = batchWorkData->jobs.begin(); iter != batchWorkData->jobs.end(); iter++)
+      iter->queueTime = batchWorkData->task.queueTime;
+
+    if (!generateBatchResult(env, batchWorkData, &result))
+      error = result;
+  }
+
+  /* Released before the callback, which may append to a frame read by the call */
+  freeBatchWorkData(env, batchWorkData);
+
+  if (env)
+    settleAsyncTask(env, &batchWorkData->task, batchWorkData->cbref, error, result);
+
+  delete batchWorkData;
+}
+
+/* Queue a parsed batch, or settle it with 'error' when parsing failed */
+static napi_value queueBatchWorkData(napi_env env, BatchWorkData *batchWorkData, bool parsed, napi_value callback, napi_value options, napi_value error) {
+  napi_value undefined, promise;
+  napi_deferred deferred;
+
+  CHECK(napi_get_undefined(env, &undefined));
+
+  promise = undefined;
+
+  if (!callback)
+    CHECK(napi_create_promise(env, &batchWorkData->task.deferred, &promise));
+
+  if (!parsed || !watchSignal(env, options, &batchWorkData->task, &error)) {
+    deferred = batchWorkData->task.deferred;
+
+    freeBatchWorkData(env, batchWorkData);
+    delete batchWorkData;
+
+    return failAsyncCall(env, callback, deferred, promise, error);
+  }
+
+  batchWorkData->task.execute = executeBatchAsyncCallback;
+  batchWorkData->task.complete = executeBatchAsyncComplete;
+  batchWorkData->task.data = batchWorkData;
+
+  if (callback)
+    CHECK(napi_create_reference(env, callback, 1, &batchWorkData->cbref));
+
+  queueAsyncTask(env, &batchWorkData->task);
+
+  return promise;
+}
+
+static napi_value executeBatchAsync(napi_env env, napi_value array, bool parallel, napi_value callback, napi_value options) {
+  napi_value undefined, error = nullptr;
+  BatchWorkData *batchWorkData = new BatchWorkData();
+  bool parsed;
+
+  CHECK(napi_get_undefined(env, &undefined));
+
+  if (!batchWorkData) {
+    napi_throw_type_error(env, nullptr, "Out of memory");
+    return undefined;
+  }
+
+  batchWorkData->parallel = parallel;
+  parsed = parseBatchWorkData(env, array, true, batchWorkData, &error);
+
+  return queueBatchWorkData(env, batchWorkData, parsed, callback, options, error);
+}
+
+static napi_value executeBatch(napi_env env, napi_callback_info info) {
+  size_t argc = 3;
+  napi_value argv[3], undefined, callback;
+  napi_valuetype valuetype;
+  bool isArray, parallel = false;
+
+  CHECK(napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+  CHECK(napi_get_undefined(env, &undefined));
+
+  CHECK(napi_is_array(env, argv[0], &isArray));
+
+  if (!isArray) {
+    napi_throw_type_error(env, nullptr, "The first argument must be a Array");
+    return undefined;
+  }
+
+  callback = argv[1];
+  CHECK(napi_typeof(env, argv[1], &valuetype));
+
+  if (valuetype == napi_object) {
+    getNamedPropertyBool(env, argv[1], "parallel", &parallel);
+
+    callback = argv[2];
+    CHECK(napi_typeof(env, argv[2], &valuetype));
+  }
+
+  return valuetype == napi_function
+             ? executeBatchAsync(env, argv[0], parallel, callback, nullptr)
+             : executeBatchSync(env, argv[0], parallel);
+}
+
+static napi_value executeBatchPromise(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2], undefined, options = nullptr;
+  napi_valuetype valuetype;
+  bool isArray, parallel = false;
+
+  CHECK(napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+  CHECK(napi_get_undefined(env, &undefined));
+
+  CHECK(napi_is_array(env, argv[0], &isArray));
+
+  if (!isArray) {
+    napi_throw_type_error(env, nullptr, "The first argument must be a Array");
+    return undefined;
+  }
+
+  CHECK(napi_typeof(env, argv[1], &valuetype));
+
+  if (valuetype == napi_object) {
+    options = argv[1];
+    getNamedPropertyBool(env, options, "parallel", &parallel);
+  }
+
+  return executeBatchAsync(env, argv[0], parallel, nullptr, options);
+}
+
+static bool parseUniverseWorkData(napi_env env, napi_value spec, napi_value array, bool async, BatchWorkData *batchWorkData, napi_value *error) {
+  napi_value optInputs, inputs;
+  napi_valuetype valuetype;
+  char funcName[64] = {0};
+  int startIdx = 0;
+  int endIdx = -1;
+  int tail = 0;
+  bool typed = false;
+  unsigned int length;
+  const TaSettings *settings;
+
+  if (!getNamedPropertyString(env, spec, "name", funcName, sizeof(funcName))) {
+    CHECK(createError(env, "Missing 'name' field", error));
+    return false;
+  }
+
+  getNamedPropertyInt32(env, spec, "startIdx", &startIdx);
+  getNamedPropertyInt32(env, spec, "endIdx", &endIdx);
+
+  if (startIdx < 0) {
+    CHECK(createError(env, "Argument 'startIdx' needs to be positive", error));
+    return false;
+  }
+
+  if (getNamedPropertyInt32(env, spec, "tail", &tail) && tail <= 0) {
+    CHECK(createError(env, "Argument 'tail' needs to be positive", error));
+    return false;
+  }
+
+  if (!getNamedProperty(env, spec, "params", &optInputs))
+    optInputs = nullptr;
+
+  getNamedPropertyBool(env, spec, "typed", &typed);
+
+  if (!parseSettings(env, spec, &settings, error))
+    return false;
+
+  CHECK(napi_get_array_length(env, array, &length));
+
+  batchWorkData->jobs.resize(length);
+
+  for (unsigned int i = 0; i < length; ++i) {
+    WorkData *workData = &batchWorkData->jobs[i];
+
+    CHECK(napi_get_element(env, array, i, &inputs));
+    CHECK(napi_typeof(env, inputs, &valuetype));
+
+    if (valuetype != napi_object) {
+      CHECK(createError(env, "Each series must be a Object", error));
+      return false;
+    }
+
+    workData->async = async;
+    workData->typed = typed;
+    workData->startIdx = startIdx;
+    workData->endIdx = endIdx;
+    workData->tail = tail;
+    workData->settings = settings;
+
+    if (!setupWorkData(env, funcName, inputs, optInputs, nullptr, workData, error))
+      return false;
+  }
+
+  return true;
+}
+
+static napi_value executeUniverseSync(napi_env env, napi_value spec, napi_value array) {
+  napi_value result, undefined, error;
+  BatchWorkData batchWorkData;
+
+  CHECK(napi_get_undefined(env, &undefined));
+
+  batchWorkData.parallel = true;
+
+  if (!parseUniverseWorkData(env, spec, array, false, &batchWorkData, &error)) {
+    freeBatchWorkData(env, &batchWorkData);
+    CHECK(napi_throw(env, error));
+    return undefined;
+  }
+
+  executeBatchWorkData(&batchWorkData);
+
+  if (!generateBatchResult(env, &batchWorkData, &result)) {
+    freeBatchWorkData(env, &batchWorkData);
+    CHECK(napi_throw(env, result));
+    return undefined;
+  }
+
+  freeBatchWorkData(env, &batchWorkData);
+  return result;
+}
+
+static napi_value executeUniverseAsync(napi_env env, napi_value spec, napi_value array, napi_value callback, napi_value options) {
+  napi_value undefined, error = nullptr;
+  BatchWorkData *batchWorkData = new BatchWorkData();
+  bool parsed;
+
+  CHECK(napi_get_undefined(env, &undefined));
+
+  if (!batchWorkData) {
+    napi_throw_type_error(env, nullptr, "Out of memory");
+    return undefined;
+  }
+
+  batchWorkData->parallel = true;
+  parsed = parseUniverseWorkData(env, spec, array, true, batchWorkData, &error);
+
+  return queueBatchWorkData(env, batchWorkData, parsed, callback, options, error);
+}
+
+/* Shared by the callback and the promise forms, 'argv[2]' is what follows the series */
+static napi_value executeUniverseCall(napi_env env, napi_callback_info info, bool promise) {
+  size_t argc = 3;
+  napi_value argv[3], undefined;
+  napi_valuetype valuetype;
+  bool isArray;
+
+  CHECK(napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+  CHECK(napi_get_undefined(env, &undefined));
+
+  CHECK(napi_typeof(env, argv[0], &valuetype));
+
+  if (valuetype != napi_object) {
+    napi_throw_type_error(env, nullptr, "The first argument must be a Object");
+    return undefined;
+  }
+
+  CHECK(napi_is_array(env, argv[1], &isArray));
+
+  if (!isArray) {
+    napi_throw_type_error(env, nullptr, "The second argument must be a Array");
+    return undefined;
+  }
+
+  CHECK(napi_typeof(env, argv[2], &valuetype));
+
+  if (promise)
+    return executeUniverseAsync(env, argv[0], argv[1], nullptr, valuetype == napi_object ? argv[2] : nullptr);
+
+  return valuetype == napi_function
+             ? executeUniverseAsync(env, argv[0], argv[1], argv[2], nullptr)
+             : executeUniverseSync(env, argv[0], argv[1]);
+}
+
+static napi_value executeUniverse(napi_env env, napi_callback_info info) {
+  return executeUniverseCall(env, info, false);
+}
+
+static napi_value executeUniversePromise(napi_env env, napi_callback_info info) {
+  return executeUniverseCall(env, info, true);
+}
+
+static bool parseSweepGrid(napi_env env, const TA_FuncInfo *funcInfo, napi_value grid, SweepData *sweep, napi_value *error) {
+  napi_value names, key, array;
+  unsigned int count;
+  char name[64];
+  size_t length;
+  double *values;
+  const TA_OptInputParameterInfo *optParaminfo;
+
+  CHECK(napi_get_property_names(env, grid, &names));
+  CHECK(napi_get_array_length(env, names, &count));
+
+  for (unsigned int i = 0; i < count; ++i) {
+    WorkData workData;
+    unsigned int index;
+
+    CHECK(napi_get_element(env, names, i, &key));
+    CHECK(napi_get_value_string_utf8(env, key, name, sizeof(name), nullptr));
+
+    for (index = 0; index < funcInfo->nbOptInput; ++index) {
+      TA_GetOptInputParameterInfo(funcInfo->handle, index, &optParaminfo);
+
+      if (strcmp(optParaminfo->paramName, name) == 0)
+        break;
+    }
+
+    if (index == funcInfo->nbOptInput) {
+      char errmsg[96] = {0};
+
+      snprintf(errmsg, sizeof(errmsg), "Unknown optional input '%s'", name);
+      CHECK(createError(env, errmsg, error));
+
+      return false;
+    }
+
+    CHECK(napi_get_property(env, grid, key, &array));
+
+    if (!(values = marshalDoubleArray(env, array, &workData, &length)) || length == 0) {
+      char errmsg[96] = {0};
+
+      snprintf(errmsg, sizeof(errmsg), "Grid '%s' must be a non-empty array of numbers", name);
+      CHECK(createError(env, errmsg, error));
+      freeWorkData(env, &workData);
+
+      return false;
+    }
+
+    /* Integer optInputs are converted to int before TA-Lib sees them */
+    if (optParaminfo->type == TA_OptInput_IntegerRange || optParaminfo->type == TA_OptInput_IntegerList) {
+      for (size_t j = 0; j < length; ++j) {
+        if (!(values[j] >= INT32_MIN && values[j] <= INT32_MAX && values[j] == floor(values[j]))) {
+          char errmsg[96] = {0};
+
+          snprintf(errmsg, sizeof(errmsg), "Grid '%s' must be an array of integers", name);
+          CHECK(createError(env, errmsg, error));
+          freeWorkData(env, &workData);
+
+          return false;
+        }
+      }
+    }
+
+    sweep->optIndexes.push_back(index);
+    sweep->values.push_back(std::vector<double>(values, values + length));
+
+    freeWorkData(env, &workData);
+  }
+
+  return true;
+}
+
+/* Row-major: the first grid input changes slowest */
+static bool setupSweepRow(napi_env env, const TA_FuncInfo *funcInfo, const SweepData *sweep, size_t row, TA_ParamHolder *funcParams, napi_value *error) {
+  TA_RetCode retCode;
+  const TA_OptInputParameterInfo *optParaminfo;
+
+  for (size_t i = sweep->values.size(); i-- > 0;) {
+    const std::vector<double> &values = sweep->values[i];
+    double value = values[row % values.size()];
+
+    row /= values.size();
+
+    TA_GetOptInputParameterInfo(funcInfo->handle, sweep->optIndexes[i], &optParaminfo);
+
+    if (optParaminfo->type == TA_OptInput_RealRange || optParaminfo->type == TA_OptInput_RealList)
+      retCode = TA_SetOptInputParamReal(funcParams, sweep->optIndexes[i], value);
+    else
+      retCode = TA_SetOptInputParamInteger(funcParams, sweep->optIndexes[i], (int)value);
+
+    if (TA_SUCCESS != retCode) {
+      CHECK(createTAError(env, retCode, error));
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static bool parseSweepWorkData(napi_env env, napi_value spec, napi_value grid, bool async, BatchWorkData *batchWorkData, napi_value *error) {
+  napi_value params, frame;
+  TA_RetCode retCode;
+  TA_FuncHandle *funcHandle;
+  const TA_FuncInfo *funcInfo;
+  const FuncLayout *layout;
+  const TA_OutputParameterInfo *outputParaminfo;
+  char funcName[64] = {0};
+  int startIdx = 0;
+  int endIdx = -1;
+  size_t rows = 1;
+  SweepData *sweep;
+  const TaSettings *settings;
+
+  if (!getNamedPropertyString(env, spec, "name", funcName, sizeof(funcName))) {
+    CHECK(createError(env, "Missing 'name' field", error));
+    return false;
+  }
+
+  if (!getNamedProperty(env, spec, "frame", &frame))
+    frame = nullptr;
+
+  if (!getNamedProperty(env, spec, "params", &params)) {
+    if (!frame) {
+      CHECK(createError(env, "Missing 'params' field", error));
+      return false;
+    }
+
+    params = frame;
+  }
+
+  getNamedPropertyInt32(env, spec, "startIdx", &startIdx);
+  getNamedPropertyInt32(env, spec, "endIdx", &endIdx);
+
+  if (startIdx < 0) {
+    CHECK(createError(env, "Argument 'startIdx' needs to be positive", error));
+    return false;
+  }
+
+  if (!parseSettings(env, spec, &settings, error))
+    return false;
+
+  if (TA_SUCCESS != (retCode = getFuncLayout(funcName, &layout))) {
+    CHECK(createTAError(env, retCode, error));
+    return false;
+  }
+
+  funcHandle = layout->funcHandle;
+  funcInfo = layout->funcInfo;
+
+  sweep = batchWorkData->sweep = new SweepData();
+
+  if (!parseSweepGrid(env, funcInfo, grid, sweep, error))
+    return false;
+
+  for (auto iter = sweep->values.begin(); iter != sweep->values.end(); iter++)
+    rows *= iter->size();
+
+  batchWorkData->jobs.resize(rows);
+
+  for (size_t i = 0; i < rows; ++i) {
+    WorkData *workData = &batchWorkData->jobs[i];
+
+    /* Inputs are marshalled once, every row reads the same buffers */
+    workData->async = async;
+    workData->inputCache = &batchWorkData->inputCache;
+    workData->funcHandle = funcHandle;
+    workData->nbOutput = funcInfo->nbOutput;
+    workData->startIdx = startIdx;
+    workData->endIdx = endIdx;
+    workData->settings = settings;
+
+    if (frame && !bindFrame(env, frame, workData, error))
+      return false;
+
+    if (TA_SUCCESS != (retCode = TA_ParamHolderAlloc(funcHandle, &workData->funcParams))) {
+      CHECK(createTAError(env, retCode, error));
+      return false;
+    }
+
+    if (!setupOptInputs(env, layout, params, workData->funcParams, error) ||
+        !setupSweepRow(env, funcInfo, sweep, i, workData->funcParams, error) ||
+        !setupInputs(env, layout, params, workData, error) ||
+        !setupOutputOffset(env, workData, error))
+      return false;
+
+    /* Every row writes a slice of the matrices sized by the first one */
+    if (i > 0 && workData->endIdx - workData->startIdx + 1 != sweep->columns) {
+      CHECK(createError(env, "Every row needs to read the same inputs", error));
+      return false;
+    }
+
+    /* The matrices are sized once the first row knows the input length */
+    if (i == 0) {
+      sweep->columns = workData->endIdx - workData->startIdx + 1;
+
+      for (unsigned int j = 0; j < funcInfo->nbOutput; ++j) {
+        TA_GetOutputParameterInfo(funcHandle, j, &outputParaminfo);
+
+        size_t size = (outputParaminfo->type == TA_Output_Real ? sizeof(double) : sizeof(int)) * rows * sweep->columns;
+        void *matrix = poolAlloc(size > 0 ? size : 1);
+
+        if (!matrix) {
+          CHECK(createError(env, "Out of memory", error));
+          return false;
+        }
+
+        sweep->matrices.push_back(matrix);
+      }
+    }
+
+    workData->outArrays.resize(funcInfo->nbOutput, nullptr);
+    workData->outBuffers.resize(funcInfo->nbOutput, nullptr);
+
+    for (unsigned int j = 0; j < funcInfo->nbOutput; ++j) {
+      TA_GetOutputParameterInfo(funcHandle, j, &outputParaminfo);
+
+      void *buffer = outputParaminfo->type == TA_Output_Real
+                         ? (void *)((double *)sweep->matrices[j] + i * sweep->columns)
+                         : (void *)((int *)sweep->matrices[j] + i * sweep->columns);
+
+      if (!bindAlignedOutput(env, workData, j, outputParaminfo->type, buffer, error))
+        return false;
+    }
+  }
+
+  batchWorkData->inputCache.arrays.clear();
+
+  return true;
+}
+
+static bool generateSweepResult(napi_env env, BatchWorkData *batchWorkData, napi_value *result) {
+  napi_value object, array, params, value;
+  SweepData *sweep = batchWorkData->sweep;
+  size_t rows = batchWorkData->jobs.size();
+  int *begIndexes;
+  const TA_OptInputParameterInfo *optParaminfo;
+  const TA_OutputParameterInfo *outputParaminfo;
+
+  for (size_t i = 0; i < rows; ++i) {
+    if (TA_SUCCESS != batchWorkData->jobs[i].retCode) {
+      CHECK(createTAError(env, batchWorkData->jobs[i].retCode, result));
+      return false;
+    }
+  }
+
+  CHECK(napi_create_object(env, result));
+  CHECK(setNamedPropertyInt32(env, *result, "rows", (int)rows));
+  CHECK(setNamedPropertyInt32(env, *result, "columns", sweep->columns));
+
+  /* First valid index of each row, in input indexes */
+  begIndexes = (int *)poolAlloc(sizeof(int) * (rows > 0 ? rows : 1));
+
+  if (!begIndexes) {
+    CHECK(createError(env, "Out of memory", result));
+    return false;
+  }
+
+  for (size_t i = 0; i < rows; ++i) {
+    const WorkData *workData = &batchWorkData->jobs[i];
+
+    begIndexes[i] = workData->outNBElement > 0 ? (int)workData->inOffset + workData->outBegIdx : workData->endIdx + 1;
+  }
+
+  if (!createExternalTypedArray(env, napi_int32_array, begIndexes, sizeof(int) * rows, 0, rows, &array)) {
+    createCopiedTypedArray(env, napi_int32_array, begIndexes, sizeof(int) * rows, rows, &array);
+    poolFree(begIndexes);
+  }
+
+  CHECK(napi_set_named_property(env, *result, "begIndex", array));
+
+  CHECK(napi_create_array_with_length(env, rows, &params));
+
+  for (size_t i = 0; i < rows; ++i) {
+    size_t row = i;
+
+    CHECK(napi_create_object(env, &value));
+
+    for (size_t j = sweep->values.size(); j-- > 0;) {
+      TA_GetOptInputParameterInfo(batchWorkData->jobs[i].funcHandle, sweep->optIndexes[j], &optParaminfo);
+      CHECK(setNamedPropertyDouble(env, value, optParaminfo->paramName, sweep->values[j][row % sweep->values[j].size()]));
+
+      row /= sweep->values[j].size();
+    }
+
+    CHECK(napi_set_element(env, params, (uint32_t)i, value));
+  }
+
+  CHECK(napi_set_named_property(env, *result, "params", params));
+
+  CHECK(napi_create_object(env, &object));
+
+  for (unsigned int i = 0; i < sweep->matrices.size(); ++i) {
+    size_t length = rows * sweep->columns;
+    napi_typedarray_type type;
+    size_t size;
+
+    TA_GetOutputParameterInfo(batchWorkData->jobs[0].funcHandle, i, &outputParaminfo);
+
+    type = outputParaminfo->type == TA_Output_Real ? napi_float64_array : napi_int32_array;
+    size = (outputParaminfo->type == TA_Output_Real ? sizeof(double) : sizeof(int)) * length;
+
+    /* The matrix takes over the buffer, it is freed by the finalizer */
+    if (createExternalTypedArray(env, type, sweep->matrices[i], size, 0, length, &array))
+      sweep->matrices[i] = nullptr;
+    else
+      createCopiedTypedArray(env, type, sweep->matrices[i], size, length, &array);
+
+    CHECK(napi_set_named_property(env, object, outputParaminfo->paramName, array));
+  }
+
+  CHECK(napi_set_named_property(env, *result, "results", object));
+
+  return true;
+}
+
+static napi_value executeSweepSync(napi_env env, napi_value spec, napi_value grid) {
+  napi_value result, undefined, error;
+  BatchWorkData batchWorkData;
+
+  CHECK(napi_get_undefined(env, &undefined));
+
+  batchWorkData.parallel = true;
+
+  if (!parseSweepWorkData(env, spec, grid, false, &batchWorkData, &error)) {
+    freeBatchWorkData(env, &batchWorkData);
+    CHECK(napi_throw(env, error));
+    return undefined;
+  }
+
+  executeBatchWorkData(&batchWorkData);
+
+  if (!generateBatchResult(env, &batchWorkData, &result)) {
+    freeBatchWorkData(env, &batchWorkData);
+    CHECK(napi_throw(env, result));
+    return undefined;
+  }
+
+  freeBatchWorkData(env, &batchWorkData);
+  return result;
+}
+
+static napi_value executeSweepAsync(napi_env env, napi_value spec, napi_value grid, napi_value callback, napi_value options) {
+  napi_value undefined, error = nullptr;
+  BatchWorkData *batchWorkData = new BatchWorkData();
+  bool parsed;
+
+  CHECK(napi_get_undefined(env, &undefined));
+
+  if (!batchWorkData) {
+    napi_throw_type_error(env, nullptr, "Out of memory");
+    return undefined;
+  }
+
+  batchWorkData->parallel = true;
+  parsed = parseSweepWorkData(env, spec, grid, true, batchWorkData, &error);
+
+  return queueBatchWorkData(env, batchWorkData, parsed, callback, options, error);
+}
+
+/* Shared by the callback and the promise forms, 'argv[2]' is what follows the grid */
+static napi_value executeSweepCall(napi_env env, napi_callback_info info, bool promise) {
+  size_t argc = 3;
+  napi_value argv[3], undefined;
+  napi_valuetype valuetype;
+
+  CHECK(napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+  CHECK(napi_get_undefined(env, &undefined));
+
+  CHECK(napi_typeof(env, argv[0], &valuetype));
+
+  if (valuetype != napi_object) {
+    napi_throw_type_error(env, nullptr, "The first argument must be a Object");
+    return undefined;
+  }
+
+  CHECK(napi_typeof(env, argv[1], &valuetype));
+
+  if (valuetype != napi_object) {
+    napi_throw_type_error(env, nullptr, "The second argument must be a Object");
+    return undefined;
+  }
+
+  CHECK(napi_typeof(env, argv[2], &valuetype));
+
+  if (promise)
+    return executeSweepAsync(env, argv[0], argv[1], nullptr, valuetype == napi_object ? argv[2] : nullptr);
+
+  return valuetype == napi_function
+             ? executeSweepAsync(env, argv[0], argv[1], argv[2], nullptr)
+             : executeSweepSync(env, argv[0], argv[1]);
+}
+
+static napi_value executeSweep(napi_env env, napi_callback_info info) {
+  return executeSweepCall(env, info, false);
+}
+
+static napi_value executeSweepPromise(napi_env env, napi_callback_info info) {
+  return executeSweepCall(env, info, true);
+}
+
+static void freePipelineData(napi_env env, PipelineData *pipelineData) {
+  for (auto iter = pipelineData->nodes.begin(); iter != pipelineData->nodes.end(); iter++)
+    if (iter->funcParams)
+      TA_ParamHolderFree(iter->funcParams);
+
+  for (auto iter = pipelineData->buffers.begin(); iter != pipelineData->buffers.end(); iter++)
+    poolFree(*iter);
+
+  for (auto iter = pipelineData->integers.begin(); iter != pipelineData->integers.end(); iter++)
+    poolFree(*iter);
+
+  pipelineData->nodes.clear();
+  pipelineData->buffers.clear();
+  pipelineData->integers.clear();
+
+  freeWorkData(env, &pipelineData->workData);
+}
+
+static int addPipelineSlot(PipelineData *pipelineData, const char *name, double *data, bool integer, bool owned) {
+  PipelineSlot slot;
+
+  snprintf(slot.name, sizeof(slot.name), "%s", name);
+  slot.data = data;
+  slot.begIdx = 0;
+  slot.lastUse = -1;
+  slot.integer = integer;
+  slot.owned = owned;
+  slot.result = false;
+
+  pipelineData->slots.push_back(slot);
+  return (int)pipelineData->slots.size() - 1;
+}
+
+/* A reference is "node.output", "node" for its first output, or the name of a series input */
+static bool resolvePipelineInput(napi_env env, PipelineData *pipelineData, napi_value inputs, napi_value nodeInputs, const char *name, int nodeIndex, int *slot, napi_value *error) {
+  char ref[128] = {0};
+  char *outputName;
+  double *data;
+  const TA_OutputParameterInfo *outputParaminfo;
+
+  if (!nodeInputs || !getNamedPropertyString(env, nodeInputs, name, ref, sizeof(ref)))
+    snprintf(ref, sizeof(ref), "%s", name);
+
+  if ((outputName = strchr(ref, '.')))
+    *outputName++ = '\0';
+
+  for (int i = nodeIndex - 1; i >= 0; --i) {
+    PipelineNode *node = &pipelineData->nodes[i];
+    unsigned int output = 0;
+
+    if (strcmp(node->id, ref) != 0)
+      continue;
+
+    if (outputName) {
+      for (output = 0; output < node->funcInfo->nbOutput; ++output) {
+        TA_GetOutputParameterInfo(node->funcHandle, output, &outputParaminfo);
+
+        if (strcmp(outputParaminfo->paramName, outputName) == 0)
+          break;
+      }
+
+      if (output == node->funcInfo->nbOutput) {
+        char errmsg[256] = {0};
+
+        snprintf(errmsg, sizeof(errmsg), "Node '%s' has no output '%s'", ref, outputName);
+        CHECK(createError(env, errmsg, error));
+
+        return false;
+      }
+    }
+
+    *slot = node->outputs[output];
+    pipelineData->slots[*slot].lastUse = nodeIndex;
+
+    return true;
+  }
+
+  if (outputName) {
+    char errmsg[256] = {0};
+
+    snprintf(errmsg, sizeof(errmsg), "Unknown node '%s', nodes can only read earlier nodes", ref);
+    CHECK(createError(env, errmsg, error));
+
+    return false;
+  }
+
+  /* Series inputs are marshalled once, whatever the number of nodes reading them */
+  for (size_t i = 0; i < pipelineData->slots.size(); ++i) {
+    if (!pipelineData->slots[i].owned && strcmp(pipelineData->slots[i].name, ref) == 0) {
+      *slot = (int)i;
+      return true;
+    }
+  }
+
+  if (!(data = getNamedPropertyDoubleArray(env, inputs, ref, &pipelineData->workData))) {
+    char errmsg[192] = {0};
+
+    snprintf(errmsg, sizeof(errmsg), "Missing '%s' field", ref);
+    CHECK(createError(env, errmsg, error));
+
+    return false;
+  }
+
+  *slot = addPipelineSlot(pipelineData, ref, data, false, false);
+  return true;
+}
+
+static bool parsePipelineNode(napi_env env, PipelineData *pipelineData, napi_value inputs, napi_value object, int nodeIndex, napi_value *error) {
+  napi_value nodeInputs, optInputs;
+  TA_RetCode retCode;
+  PipelineNode *node = &pipelineData->nodes[nodeIndex];
+  const FuncLayout *layout;
+  char funcName[64] = {0};
+  int slot;
+  const TA_InputParameterInfo *inputParaminfo;
+  const TA_OutputParameterInfo *outputParaminfo;
+
+  if (!getNamedPropertyString(env, object, "name", funcName, sizeof(funcName))) {
+    CHECK(createError(env, "Missing 'name' field", error));
+    return false;
+  }
+
+  /* Nodes are named after their function unless they have an 'id' */
+  if (!getNamedPropertyString(env, object, "id", node->id, sizeof(node->id)))
+    snprintf(node->id, sizeof(node->id), "%s", funcName);
+
+  for (int i = 0; i < nodeIndex; ++i) {
+    if (strcmp(pipelineData->nodes[i].id, node->id) == 0) {
+      char errmsg[128] = {0};
+
+      snprintf(errmsg, sizeof(errmsg), "Duplicate node '%s'", node->id);
+      CHECK(createError(env, errmsg, error));
+
+      return false;
+    }
+  }
+
+  if (TA_SUCCESS != (retCode = getFuncLayout(funcName, &layout)) ||
+      TA_SUCCESS != (retCode = TA_ParamHolderAlloc(layout->funcHandle, &node->funcParams))) {
+    CHECK(createTAError(env, retCode, error));
+    return false;
+  }
+
+  node->funcHandle = layout->funcHandle;
+  node->funcInfo = layout->funcInfo;
+
+  if (getNamedProperty(env, object, "params", &optInputs) && !setupOptInputs(env, layout, optInputs, node->funcParams, error))
+    return false;
+
+  if (TA_SUCCESS != (retCode = getLookback(pipelineData->workData.settings, node->funcParams, &node->lookback))) {
+    CHECK(createTAError(env, retCode, error));
+    return false;
+  }
+
+  if (!getNamedProperty(env, object, "inputs", &nodeInputs))
+    nodeInputs = nullptr;
+
+  /* Price inputs take one slot per component, -1 for the unused ones */
+  for (unsigned int i = 0; i < node->funcInfo->nbInput; ++i) {
+    TA_GetInputParameterInfo(node->funcHandle, i, &inputParaminfo);
+
+    if (inputParaminfo->type != TA_Input_Price) {
+      if (!resolvePipelineInput(env, pipelineData, inputs, nodeInputs, inputParaminfo->paramName, nodeIndex, &slot, error))
+        return false;
+
+      node->inputs.push_back(slot);
+      continue;
+    }
+
+    for (int j = 0; j < arraysize(priceFlags); ++j) {
+      slot = -1;
+
+      if ((inputParaminfo->flags & priceFlags[j]) && !resolvePipelineInput(env, pipelineData, inputs, nodeInputs, priceNames[j], nodeIndex, &slot, error))
+        return false;
+
+      node->inputs.push_back(slot);
+    }
+  }
+
+  for (unsigned int i = 0; i < node->funcInfo->nbOutput; ++i) {
+    TA_GetOutputParameterInfo(node->funcHandle, i, &outputParaminfo);
+    node->outputs.push_back(addPipelineSlot(pipelineData, outputParaminfo->paramName, nullptr, outputParaminfo->type == TA_Output_Integer, true));
+  }
+
+  return true;
+}
+
+static bool parsePipelineData(napi_env env, napi_value spec, bool async, PipelineData *pipelineData, napi_value *error) {
+  napi_value inputs, nodes, outputs, value;
+  napi_valuetype valuetype;
+  unsigned int length;
+  bool isArray;
+
+  if (!getNamedProperty(env, spec, "inputs", &inputs)) {
+    CHECK(createError(env, "Missing 'inputs' field", error));
+    return false;
+  }
+
+  if (!getNamedProperty(env, spec, "nodes", &nodes)) {
+    CHECK(createError(env, "Missing 'nodes' field", error));
+    return false;
+  }
+
+  /* Every node runs under the settings of the pipeline */
+  if (!parseSettings(env, spec, &pipelineData->workData.settings, error))
+    return false;
+
+  CHECK(napi_is_array(env, nodes, &isArray));
+
+  if (!isArray) {
+    CHECK(createError(env, "Field 'nodes' must be a Array", error));
+    return false;
+  }
+
+  pipelineData->workData.async = async;
+
+  /* A frame can stand for the pipeline inputs */
+  if (getFrameData(env, inputs) && !bindFrame(env, inputs, &pipelineData->workData, error))
+    return false;
+
+  CHECK(napi_get_array_length(env, nodes, &length));
+
+  if (length == 0) {
+    CHECK(createError(env, "A pipeline needs at least one node", error));
+    return false;
+  }
+
+  /* Slots are addressed by index, the vector can grow while parsing */
+  pipelineData->nodes.resize(length);
+
+  for (unsigned int i = 0; i < length; ++i) {
+    pipelineData->nodes[i].funcParams = nullptr;
+    pipelineData->nodes[i].result = false;
+  }
+
+  for (unsigned int i = 0; i < length; ++i) {
+    CHECK(napi_get_element(env, nodes, i, &value));
+    CHECK(napi_typeof(env, value, &valuetype));
+
+    if (valuetype != napi_object) {
+      CHECK(createError(env, "Each node must be a Object", error));
+      return false;
+    }
+
+    if (!parsePipelineNode(env, pipelineData, inputs, value, (int)i, error))
+      return false;
+  }
+
+  /* Without 'outputs', the results are the nodes nobody reads */
+  if (getNamedProperty(env, spec, "outputs", &outputs)) {
+    unsigned int count;
+    char id[64];
+
+    CHECK(napi_get_array_length(env, outputs, &count));
+
+    for (unsigned int i = 0; i < count; ++i) {
+      unsigned int j;
+
+      CHECK(napi_get_element(env, outputs, i, &value));
+      CHECK(napi_get_value_string_utf8(env, value, id, sizeof(id), nullptr));
+
+      for (j = 0; j < length && strcmp(pipelineData->nodes[j].id, id) != 0; ++j)
+        ;
+
+      if (j == length) {
+        char errmsg[128] = {0};
+
+        snprintf(errmsg, sizeof(errmsg), "Unknown node '%s'", id);
+        CHECK(createError(env, errmsg, error));
+
+        return false;
+      }
+
+      pipelineData->nodes[j].result = true;
+    }
+  } else {
+    for (auto node = pipelineData->nodes.begin(); node != pipelineData->nodes.end(); node++) {
+      node->result = true;
+
+      for (auto slot = node->outputs.begin(); slot != node->outputs.end(); slot++)
+        node->result = node->result && pipelineData->slots[*slot].lastUse < 0;
+    }
+  }
+
+  for (auto node = pipelineData->nodes.begin(); node != pipelineData->nodes.end(); node++)
+    for (auto slot = node->outputs.begin(); slot != node->outputs.end(); slot++)
+      pipelineData->slots[*slot].result = node->result;
+
+  return true;
+}
+
+static double *acquirePipelineBuffer(PipelineData *pipelineData) {
+  double *buffer;
+
+  if (pipelineData->pool.size() > 0) {
+    buffer = pipelineData->pool.back();
+    pipelineData->pool.pop_back();
+    return buffer;
+  }
+
+  if (!(buffer = (double *)poolAlloc(sizeof(double) * pipelineData->workData.inLength)))
+    return nullptr;
+
+  pipelineData->buffers.push_back(buffer);
+  return buffer;
+}
+
+static int *getPipelineIntegers(PipelineData *pipelineData, size_t index) {
+  int *integers;
+
+  while (pipelineData->integers.size() <= index) {
+    if (!(integers = (int *)poolAlloc(sizeof(int) * pipelineData->workData.inLength)))
+      return nullptr;
+
+    pipelineData->integers.push_back(integers);
+  }
+
+  return pipelineData->integers[index];
+}
+
+static void releasePipelineSlot(PipelineData *pipelineData, int index, int nodeIndex) {
+  PipelineSlot *slot = &pipelineData->slots[index];
+
+  if (!slot->owned || slot->result || !slot->data || slot->lastUse > nodeIndex)
+    return;
+
+  pipelineData->pool.push_back(slot->data);
+  slot->data = nullptr;
+}
+
+/* Inputs are bound from the latest first valid index of the node's inputs */
+static TA_RetCode runPipelineNode(PipelineData *pipelineData, int nodeIndex) {
+  PipelineNode *node = &pipelineData->nodes[nodeIndex];
+  int length = (int)pipelineData->workData.inLength;
+  int begIdx = 0;
+  int outBegIdx = 0;
+  int outNBElement = 0;
+  size_t nbInteger = 0;
+  unsigned int k = 0;
+  std::vector<int *> outIntegers;
+  TA_RetCode retCode;
+  const TA_InputParameterInfo *inputParaminfo;
+  const TA_OutputParameterInfo *outputParaminfo;
+
+  for (auto iter = node->inputs.begin(); iter != node->inputs.end(); iter++)
+    if (*iter >= 0 && pipelineData->slots[*iter].begIdx > begIdx)
+      begIdx = pipelineData->slots[*iter].begIdx;
+
+  if (begIdx + node->lookback < length) {
+    for (unsigned int i = 0; i < node->funcInfo->nbInput; ++i) {
+      TA_GetInputParameterInfo(node->funcHandle, i, &inputParaminfo);
+
+      if (inputParaminfo->type == TA_Input_Price) {
+        double *prices[arraysize(priceFlags)] = {nullptr};
+
+        for (int j = 0; j < arraysize(priceFlags); ++j, ++k)
+          if (node->inputs[k] >= 0)
+            prices[j] = pipelineData->slots[node->inputs[k]].data + begIdx;
+
+        retCode = TA_SetInputParamPricePtr(node->funcParams, i, prices[0], prices[1], prices[2], prices[3], prices[4], prices[5]);
+      } else if (inputParaminfo->type == TA_Input_Real) {
+        retCode = TA_SetInputParamRealPtr(node->funcParams, i, pipelineData->slots[node->inputs[k++]].data + begIdx);
+      } else {
+        const double *data = pipelineData->slots[node->inputs[k++]].data + begIdx;
+        int *integers = getPipelineIntegers(pipelineData, nbInteger++);
+
+        if (!integers)
+          return TA_ALLOC_ERR;
+
+        convertArray(data, integers, length - begIdx);
+        retCode = TA_SetInputParamIntegerPtr(node->funcParams, i, integers);
+      }
+
+      if (TA_SUCCESS != retCode)
+        return retCode;
+    }
+
+    /* TA-Lib writes the outputs from the lookback on, integers go through a scratch buffer */
+    outIntegers.resize(node->funcInfo->nbOutput, nullptr);
+
+    for (unsigned int i = 0; i < node->funcInfo->nbOutput; ++i) {
+      PipelineSlot *slot = &pipelineData->slots[node->outputs[i]];
+
+      if (!(slot->data = acquirePipelineBuffer(pipelineData)))
+        return TA_ALLOC_ERR;
+
+      TA_GetOutputParameterInfo(node->funcHandle, i, &outputParaminfo);
+
+      if (outputParaminfo->type == TA_Output_Real) {
+        retCode = TA_SetOutputParamRealPtr(node->funcParams, i, slot->data + begIdx + node->lookback);
+      } else {
+        if (!(outIntegers[i] = getPipelineIntegers(pipelineData, nbInteger++)))
+          return TA_ALLOC_ERR;
+
+        retCode = TA_SetOutputParamIntegerPtr(node->funcParams, i, outIntegers[i]);
+      }
+
+      if (TA_SUCCESS != retCode)
+        return retCode;
+    }
+
+    if (TA_SUCCESS != (retCode = TA_CallFunc(node->funcParams, 0, length - begIdx - 1, &outBegIdx, &outNBElement)))
+      return retCode;
+
+    for (unsigned int i = 0; i < node->funcInfo->nbOutput; ++i) {
+      PipelineSlot *slot = &pipelineData->slots[node->outputs[i]];
+      double *output = slot->data + begIdx + outBegIdx;
+
+      if (outIntegers[i])
+        convertArray(outIntegers[i], output, outNBElement);
+      else if (outBegIdx != node->lookback && outNBElement > 0)
+        memmove(output, slot->data + begIdx + node->lookback, sizeof(double) * outNBElement);
+
+      slot->begIdx = outNBElement > 0 ? begIdx + outBegIdx : length;
+    }
+  } else {
+    for (auto iter = node->outputs.begin(); iter != node->outputs.end(); iter++)
+      pipelineData->slots[*iter].begIdx = length;
+  }
+
+  for (auto iter = node->inputs.begin(); iter != node->inputs.end(); iter++)
+    if (*iter >= 0)
+      releasePipelineSlot(pipelineData, *iter, nodeIndex);
+
+  for (auto iter = node->outputs.begin(); iter != node->outputs.end(); iter++)
+    releasePipelineSlot(pipelineData, *iter, nodeIndex);
+
+  return TA_SUCCESS;
+}
+
+static void executePipelineData(PipelineData *pipelineData) {
+  settingsLoad(pipelineData->workData.settings);
+
+  for (size_t i = 0; i < pipelineData->nodes.size(); ++i)
+    if (TA_SUCCESS != (pipelineData->retCode = runPipelineNode(pipelineData, (int)i)))
+      break;
+}
+
+static bool generatePipelineResult(napi_env env, PipelineData *pipelineData, napi_value *result) {
+  napi_value object, results, array;
+  int length = (int)pipelineData->workData.inLength;
+
+  if (TA_SUCCESS != pipelineData->retCode) {
+    CHECK(createTAError(env, pipelineData->retCode, result));
+    return false;
+  }
+
+  CHECK(napi_create_object(env, result));
+
+  for (auto node = pipelineData->nodes.begin(); node != pipelineData->nodes.end(); node++) {
+    int begIdx = length;
+
+    if (!node->result)
+      continue;
+
+    CHECK(napi_create_object(env, &object));
+    CHECK(napi_create_object(env, &results));
+
+    for (auto iter = node->outputs.begin(); iter != node->outputs.end(); iter++) {
+      PipelineSlot *slot = &pipelineData->slots[*iter];
+      size_t nbElement = length - slot->begIdx;
+
+      begIdx = slot->begIdx;
+
+      if (slot->integer) {
+        int *integers;
+
+        CHECK(napi_create_arraybuffer(env, sizeof(int) * nbElement, (void **)&integers, &array));
+
+        if (nbElement > 0)
+          convertArray(slot->data + slot->begIdx, integers, nbElement);
+
+        CHECK(napi_create_typedarray(env, napi_int32_array, nbElement, array, 0, &array));
+      } else if (!slot->data || nbElement == 0) {
+        createCopiedTypedArray(env, napi_float64_array, nullptr, 0, 0, &array);
+      } else if (createExternalTypedArray(env, napi_float64_array, slot->data, sizeof(double) * length, sizeof(double) * slot->begIdx, nbElement, &array)) {
+        /* The result takes over the buffer, it is freed by the finalizer */
+        for (auto buffer = pipelineData->buffers.begin(); buffer != pipelineData->buffers.end(); buffer++)
+          if (*buffer == slot->data)
+            *buffer = nullptr;
+      } else {
+        createCopiedTypedArray(env, napi_float64_array, slot->data + slot->begIdx, sizeof(double) * nbElement, nbElement, &array);
+      }
+
+      CHECK(napi_set_named_property(env, results, slot->name, array));
+    }
+
+    CHECK(setNamedPropertyInt32(env, object, "begIndex", begIdx));
+    CHECK(setNamedPropertyInt32(env, object, "nbElement", length - begIdx));
+    CHECK(napi_set_named_property(env, object, "results", results));
+
+    CHECK(napi_set_named_property(env, *result, node->id, object));
+  }
+
+  return true;
+}
+
+static napi_value executePipelineSync(napi_env env, napi_value spec) {
+  napi_value result, undefined, error;
+  PipelineData pipelineData;
+
+  CHECK(napi_get_undefined(env, &undefined));
+
+  if (!parsePipelineData(env, spec, false, &pipelineData, &error)) {
+    freePipelineData(env, &pipelineData);
+    CHECK(napi_throw(env, error));
+    return undefined;
+  }
+
+  executePipelineData(&pipelineData);
+
+  if (!generatePipelineResult(env, &pipelineData, &result)) {
+    freePipelineData(env, &pipelineData);
+    CHECK(napi_throw(env, result));
+    return undefined;
+  }
+
+  freePipelineData(env, &pipelineData);
+  return result;
+}
+
+static void executePipelineAsyncCallback(void *data) {
+  executePipelineData((PipelineData *)data);
+}
+
+static void executePipelineAsyncComplete(napi_env env, void *data) {
+  PipelineData *pipelineData = (PipelineData *)data;
+  napi_value undefined, callback, argv[2];
+
+  if (env) {
+    CHECK(napi_get_undefined(env, &undefined));
+    CHECK(napi_get_reference_value(env, pipelineData->cbref, &callback));
+
+    argv[0] = undefined;
+
+    if (!generatePipelineResult(env, pipelineData, &argv[1])) {
+      argv[0] = argv[1];
+      argv[1] = undefined;
+    }
+  }
+
+  /* Released before the callback, which may append to a frame read by the call */
+  freePipelineData(env, pipelineData);
+
+  if (env) {
+    CHECK(napi_call_function(env, undefined, callback, 2, argv, nullptr));
+    CHECK(napi_delete_reference(env, pipelineData->cbref));
+  }
+
+  delete pipelineData;
+}
+
+static napi_value executePipelineAsync(napi_env env, napi_value spec, napi_value callback) {
+  napi_value undefined, argv[2];
+  PipelineData *pipelineData = new PipelineData();
+
+  CHECK(napi_get_undefined(env, &undefined));
+
+  if (!pipelineData) {
+    napi_throw_type_error(env, nullptr, "Out of memory");
+    return undefined;
+  }
+
+  if (!parsePipelineData(env, spec, true, pipelineData, &argv[0])) {
+    argv[1] = undefined;
+
+    freePipelineData(env, pipelineData);
+    delete pipelineData;
+
+    CHECK(napi_call_function(env, undefined, callback, 2, argv, nullptr));
+    return undefined;
+  }
+
+  pipelineData->task.execute = executePipelineAsyncCallback;
+  pipelineData->task.complete = executePipelineAsyncComplete;
+  pipelineData->task.data = pipelineData;
+
+  CHECK(napi_create_reference(env, callback, 1, &pipelineData->cbref));
+  queueAsyncTask(env, &pipelineData->task);
+
+  return undefined;
+}
+
+static napi_value executePipeline(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2], undefined;
+  napi_valuetype valuetype;
+
+  CHECK(napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+  CHECK(napi_get_undefined(env, &undefined));
+
+  CHECK(napi_typeof(env, argv[0], &valuetype));
+
+  if (valuetype != napi_object) {
+    napi_throw_type_error(env, nullptr, "The first argument must be a Object");
+    return undefined;
+  }
+
+  CHECK(napi_typeof(env, argv[1], &valuetype));
+
+  return valuetype == napi_function
+             ? executePipelineAsync(env, argv[0], argv[1])
+             : executePipelineSync(env, argv[0]);
+}
+
+static void freeCandleScanData(napi_env env, CandleScanData *scanData) {
+  for (auto iter = scanData->funcParams.begin(); iter != scanData->funcParams.end(); iter++)
+    TA_ParamHolderFree(*iter);
+
+  scanData->funcParams.clear();
+
+  poolFree(scanData->matrix);
+  scanData->matrix = nullptr;
+
+  freeWorkData(env, &scanData->workData);
+}
+
+static bool addCandlePattern(napi_env env, CandleScanData *scanData, const char *funcName, napi_value optInputs, napi_value *error) {
+  TA_RetCode retCode;
+  const FuncLayout *layout;
+  const TA_FuncInfo *funcInfo;
+  TA_ParamHolder *funcParams;
+
+  if (TA_SUCCESS != (retCode = getFuncLayout(funcName, &layout))) {
+    CHECK(createTAError(env, retCode, error));
+    return false;
+  }
+
+  funcInfo = layout->funcInfo;
+
+  if (strcmp(funcInfo->group, "Pattern Recognition") != 0) {
+    char errmsg[96] = {0};
+
+    snprintf(errmsg, sizeof(errmsg), "'%s' is not a candlestick pattern", funcName);
+    CHECK(createError(env, errmsg, error));
+
+    return false;
+  }
+
+  if (TA_SUCCESS != (retCode = TA_ParamHolderAlloc(layout->funcHandle, &funcParams))) {
+    CHECK(createTAError(env, retCode, error));
+    return false;
+  }
+
+  scanData->funcParams.push_back(funcParams);
+  scanData->names.push_back(funcInfo->name);
+
+  /* Every pattern takes a single OHLC price input */
+  if (TA_SUCCESS != (retCode = TA_SetInputParamPricePtr(funcParams, 0, scanData->open, scanData->high, scanData->low, scanData->close, nullptr, nullptr))) {
+    CHECK(createTAError(env, retCode, error));
+    return false;
+  }
+
+  return !optInputs || setupOptInputs(env, layout, optInputs, funcParams, error);
+}
+
+static bool parseCandleScanData(napi_env env, napi_value spec, bool async, CandleScanData *scanData, napi_value *error) {
+  napi_value inputs, patterns, optInputs, value;
+  unsigned int count;
+  char funcName[64];
+  WorkData *workData = &scanData->workData;
+  double **prices[] = {&scanData->open, &scanData->high, &scanData->low, &scanData->close};
+
+  if (!getNamedProperty(env, spec, "inputs", &inputs)) {
+    CHECK(createError(env, "Missing 'inputs' field", error));
+    return false;
+  }
+
+  workData->async = async;
+
+  if (getFrameData(env, inputs) && !bindFrame(env, inputs, workData, error))
+    return false;
+
+  /* Marshalled once, every pattern reads the same buffers */
+  for (int i = 0; i < arraysize(prices); ++i) {
+    if (!(*prices[i] = getNamedPropertyDoubleArray(env, inputs, priceNames[i], workData))) {
+      char errmsg[64] = {0};
+
+      snprintf(errmsg, sizeof(errmsg), "Missing '%s' field", priceNames[i]);
+      CHECK(createError(env, errmsg, error));
+
+      return false;
+    }
+  }
+
+  scanData->bars = workData->inLength;
+
+  if (!parseSettings(env, spec, &workData->settings, error))
+    return false;
+
+  if (!getNamedProperty(env, spec, "optInputs", &optInputs))
+    optInputs = nullptr;
+
+  if (getNamedProperty(env, spec, "patterns", &patterns)) {
+    CHECK(napi_get_array_length(env, patterns, &count));
+
+    for (unsigned int i = 0; i < count; ++i) {
+      CHECK(napi_get_element(env, patterns, i, &value));
+      CHECK(napi_get_value_string_utf8(env, value, funcName, sizeof(funcName), nullptr));
+
+      if (!addCandlePattern(env, scanData, funcName, optInputs, error))
+        return false;
+    }
+  } else {
+    TA_StringTable *funcTable;
+
+    if (TA_SUCCESS == TA_FuncTableAlloc("Pattern Recognition", &funcTable)) {
+      for (unsigned int i = 0; i < funcTable->size; ++i) {
+        if (!addCandlePattern(env, scanData, funcTable->string[i], optInputs, error)) {
+          TA_FuncTableFree(funcTable);
+          return false;
+        }
+      }
+
+      TA_FuncTableFree(funcTable);
+    }
+  }
+
+  scanData->retCodes.assign(scanData->funcParams.size(), TA_SUCCESS);
+  scanData->matrix = (int8_t *)poolAlloc(scanData->funcParams.size() * scanData->bars);
+
+  if (!scanData->matrix) {
+    CHECK(createError(env, "Out of memory", error));
+    return false;
+  }
+
+  return true;
+}
+
+/* Fills the pattern's row, TA-Lib answers +/-100 (or 200 when confirmed) */
+static void scanCandlePattern(void *data, int index) {
+  CandleScanData *scanData = (CandleScanData *)data;
+  TA_ParamHolder *funcParams = scanData->funcParams[index];
+  int8_t *row = scanData->matrix + (size_t)index * scanData->bars;
+  int outBegIdx = 0, outNBElement = 0;
+  TA_RetCode retCode;
+  int *outInteger;
+
+  memset(row, 0, scanData->bars);
+
+  if (scanData->bars == 0)
+    return;
+
+  if (!(outInteger = (int *)poolAlloc(sizeof(int) * scanData->bars))) {
+    scanData->retCodes[index] = TA_ALLOC_ERR;
+    return;
+  }
+
+  if (TA_SUCCESS == (retCode = TA_SetOutputParamIntegerPtr(funcParams, 0, outInteger))) {
+    settingsLoad(scanData->workData.settings);
+    retCode = TA_CallFunc(funcParams, 0, (int)scanData->bars - 1, &outBegIdx, &outNBElement);
+  }
+
+  for (int i = 0; retCode == TA_SUCCESS && i < outNBElement; ++i)
+    row[outBegIdx + i] = (int8_t)(outInteger[i] / 100);
+
+  scanData->retCodes[index] = retCode;
+  poolFree(outInteger);
+}
+
+static void executeCandleScanData(CandleScanData *scanData) {
+  executorParallelFor((int)scanData->funcParams.size(), 1, scanCandlePattern, scanData);
+}
+
+static bool generateCandleScanResult(napi_env env, CandleScanData *scanData, napi_value *result) {
+  napi_value patterns, matrix;
+  size_t size = scanData->funcParams.size() * scanData->bars;
+
+  for (size_t i = 0; i < scanData->retCodes.size(); ++i) {
+    if (TA_SUCCESS != scanData->retCodes[i]) {
+      CHECK(createTAError(env, scanData->retCodes[i], result));
+      return false;
+    }
+  }
+
+  CHECK(napi_create_object(env, result));
+  CHECK(napi_create_array_with_length(env, scanData->names.size(), &patterns));
+
+  for (size_t i = 0; i < scanData->names.size(); ++i)
+    CHECK(setArrayString(env, patterns, (uint32_t)i, scanData->names[i]));
+
+  CHECK(napi_set_named_property(env, *result, "patterns", patterns));
+  CHECK(setNamedPropertyInt32(env, *result, "bars", (int)scanData->bars));
+
+  /* The matrix takes over the buffer, it is freed by the finalizer */
+  if (createExternalTypedArray(env, napi_int8_array, scanData->matrix, size, 0, size, &matrix))
+    scanData->matrix = nullptr;
+  else
+    createCopiedTypedArray(env, napi_int8_array, scanData->matrix, size, size, &matrix);
+
+  CHECK(napi_set_named_property(env, *result, "matrix", matrix));
+
+  return true;
+}
+
+static napi_value scanCandlesSync(napi_env env, napi_value spec) {
+  napi_value result, undefined, error;
+  CandleScanData scanData;
+
+  CHECK(napi_get_undefined(env, &undefined));
+
+  if (!parseCandleScanData(env, spec, false, &scanData, &error)) {
+    freeCandleScanData(env, &scanData);
+    CHECK(napi_throw(env, error));
+    return undefined;
+  }
+
+  executeCandleScanData(&scanData);
+
+  if (!generateCandleScanResult(env, &scanData, &result)) {
+    freeCandleScanData(env, &scanData);
+    CHECK(napi_throw(env, result));
+    return undefined;
+  }
+
+  freeCandleScanData(env, &scanData);
+  return result;
+}
+
+static void scanCandlesAsyncCallback(void *data) {
+  executeCandleScanData((CandleScanData *)data);
+}
+
+static void scanCandlesAsyncComplete(napi_env env, void *data) {
+  CandleScanData *scanData = (CandleScanData *)data;
+  napi_value undefined, callback, argv[2];
+
+  if (env) {
+    CHECK(napi_get_undefined(env, &undefined));
+    CHECK(napi_get_reference_value(env, scanData->cbref, &callback));
+
+    argv[0] = undefined;
+
+    if (!generateCandleScanResult(env, scanData, &argv[1])) {
+      argv[0] = argv[1];
+      argv[1] = undefined;
+    }
+  }
+
+  /* Released before the callback, which may append to a frame read by the call */
+  freeCandleScanData(env, scanData);
+
+  if (env) {
+    CHECK(napi_call_function(env, undefined, callback, 2, argv, nullptr));
+    CHECK(napi_delete_reference(env, scanData->cbref));
+  }
+
+  delete scanData;
+}
+
+static napi_value scanCandlesAsync(napi_env env, napi_value spec, napi_value callback) {
+  napi_value undefined, argv[2];
+  CandleScanData *scanData = new CandleScanData();
+
+  CHECK(napi_get_undefined(env, &undefined));
+
+  if (!parseCandleScanData(env, spec, true, scanData, &argv[0])) {
+    argv[1] = undefined;
+
+    freeCandleScanData(env, scanData);
+    delete scanData;
+
+    CHECK(napi_call_function(env, undefined, callback, 2, argv, nullptr));
+    return undefined;
+  }
+
+  scanData->task.execute = scanCandlesAsyncCallback;
+  scanData->task.complete = scanCandlesAsyncComplete;
+  scanData->task.data = scanData;
+
+  CHECK(napi_create_reference(env, callback, 1, &scanData->cbref));
+  queueAsyncTask(env, &scanData->task);
+
+  return undefined;
+}
+
+static napi_value scanCandles(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2], undefined;
+  napi_valuetype valuetype;
+
+  CHECK(napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+  CHECK(napi_get_undefined(env, &undefined));
+
+  CHECK(napi_typeof(env, argv[0], &valuetype));
+
+  if (valuetype != napi_object) {
+    napi_throw_type_error(env, nullptr, "The first argument must be a Object");
+    return undefined;
+  }
+
+  CHECK(napi_typeof(env, argv[1], &valuetype));
+
+  return valuetype == napi_function
+             ? scanCandlesAsync(env, argv[0], argv[1])
+             : scanCandlesSync(env, argv[0]);
+}
+
+static void freePreparedFunc(PreparedFunc *preparedFunc) {
+  if (preparedFunc->funcParams)
+    TA_ParamHolderFree(preparedFunc->funcParams);
+
+  delete preparedFunc;
+}
+
+static void finalizePreparedFunc(napi_env env, void *data, void *hint) {
+  freePreparedFunc((PreparedFunc *)data);
+}
+
+static void freePreparedWorkData(napi_env env, WorkData *workData) {
+  /* The ParamHolder belongs to the prepared function */
+  workData->funcParams = nullptr;
+  freeWorkData(env, workData);
+}
+
+static napi_value runPrepared(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2], self, undefined, result, error;
+  napi_valuetype valuetype;
+  PreparedFunc *preparedFunc;
+  WorkData workData;
+
+  CHECK(napi_get_cb_info(env, info, &argc, argv, &self, nullptr));
+  CHECK(napi_get_undefined(env, &undefined));
+
+  if (napi_ok != napi_unwrap(env, self, (void **)&preparedFunc)) {
+    napi_throw_type_error(env, nullptr, "Illegal invocation");
+    return undefined;
+  }
+
+  CHECK(napi_typeof(env, argv[0], &valuetype));
+
+  if (valuetype != napi_object) {
+    napi_throw_type_error(env, nullptr, "The first argument must be a Object");
+    return undefined;
+  }
+
+  workData.funcHandle = preparedFunc->layout->funcHandle;
+  workData.funcParams = preparedFunc->funcParams;
+  workData.nbOutput = preparedFunc->layout->funcInfo->nbOutput;
+  workData.singleFunc = preparedFunc->layout->singleFunc;
+  workData.kernel = preparedFunc->layout->kernel;
+  workData.rolling = preparedFunc->layout->rolling;
+  workData.optInputs = preparedFunc->optInputs;
+  workData.settings = preparedFunc->settings;
+  workData.endIdx = -1;
+  workData.typed = true;
+
+  /* A frame is read in place instead of a series object */
+  workData.frame = getFrameData(env, argv[0]);
+  workData.parseTime = now();
+
+  if (!setupInputs(env, preparedFunc->layout, argv[0], &workData, &error) ||
+      !setupOutputs(env, preparedFunc->layout, argc > 1 ? argv[1] : nullptr, &workData, &error)) {
+    freePreparedWorkData(env, &workData);
+    CHECK(napi_throw(env, error));
+    return undefined;
+  }
+
+  workData.parseTime = now() - workData.parseTime;
+
+  executeWorkData(&workData);
+
+  if (!generateResult(env, &workData, &result)) {
+    freePreparedWorkData(env, &workData);
+    CHECK(napi_throw(env, result));
+    return undefined;
+  }
+
+  freePreparedWorkData(env, &workData);
+  return result;
+}
+
+static napi_value constructInstance(napi_env env, napi_callback_info info) {
+  napi_value self;
+
+  CHECK(napi_get_cb_info(env, info, nullptr, nullptr, &self, nullptr));
+
+  return self;
+}
+
+static napi_value prepare(napi_env env, napi_callback_info info) {
+  size_t argc = 3;
+  napi_value argv[3], undefined, constructor, object, error;
+  napi_valuetype valuetype;
+  TA_RetCode retCode;
+  AddonData *addonData;
+  PreparedFunc *preparedFunc;
+  char funcName[64] = {0};
+
+  CHECK(napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+  CHECK(napi_get_undefined(env, &undefined));
+
+  CHECK(napi_typeof(env, argv[0], &valuetype));
+
+  if (valuetype != napi_string) {
+    napi_throw_type_error(env, nullptr, "The first argument must be a String");
+    return undefined;
+  }
+
+  CHECK(napi_get_value_string_utf8(env, argv[0], funcName, sizeof(funcName), nullptr));
+
+  preparedFunc = new PreparedFunc();
+  preparedFunc->funcParams = nullptr;
+  preparedFunc->settings = nullptr;
+
+  if (TA_SUCCESS != (retCode = getFuncLayout(funcName, &preparedFunc->layout)) ||
+      TA_SUCCESS != (retCode = TA_ParamHolderAlloc(preparedFunc->layout->funcHandle, &preparedFunc->funcParams))) {
+    freePreparedFunc(preparedFunc);
+
+    CHECK(createTAError(env, retCode, &error));
+    CHECK(napi_throw(env, error));
+
+    return undefined;
+  }
+
+  CHECK(napi_typeof(env, argv[1], &valuetype));
+
+  if (valuetype == napi_object && !setupOptInputs(env, preparedFunc->layout, argv[1], preparedFunc->funcParams, &error)) {
+    freePreparedFunc(preparedFunc);
+    CHECK(napi_throw(env, error));
+    return undefined;
+  }
+
+  readOptInputs(env, preparedFunc->layout, valuetype == napi_object ? argv[1] : nullptr, &preparedFunc->optInputs);
+
+  CHECK(napi_typeof(env, argv[2], &valuetype));
+
+  if (!parseSettings(env, valuetype == napi_object ? argv[2] : nullptr, &preparedFunc->settings, &error)) {
+    freePreparedFunc(preparedFunc);
+    CHECK(napi_throw(env, error));
+    return undefined;
+  }
+
+  CHECK(napi_get_instance_data(env, (void **)&addonData));
+  CHECK(napi_get_reference_value(env, addonData->preparedConstructor, &constructor));
+  CHECK(napi_new_instance(env, constructor, 0, nullptr, &object));
+  CHECK(napi_wrap(env, object, preparedFunc, finalizePreparedFunc, nullptr, nullptr));
+
+  CHECK(setNamedPropertyString(env, object, "name", preparedFunc->layout->funcInfo->name));
+
+  return object;
+}
+
+static void freeStreamData(StreamData *streamData) {
+  if (streamData->stream)
+    streamFree(streamData->stream);
+
+  if (streamData->funcParams)
+    TA_ParamHolderFree(streamData->funcParams);
+
+  delete streamData;
+}
+
+static void finalizeStreamData(napi_env env, void *data, void *hint) {
+  freeStreamData((StreamData *)data);
+}
+
+static TA_RetCode callStreamFunc(StreamData *streamData, int *outBegIdx, int *outNBElement) {
+  int length = (int)streamData->columns[0].size();
+  unsigned int column = 0;
+  TA_RetCode retCode;
+  const TA_InputParameterInfo *inputParaminfo;
+
+  /* Columns grow, so the pointers are bound again on every call */
+  for (unsigned int i = 0; i < streamData->funcInfo->nbInput; ++i) {
+    TA_GetInputParameterInfo(streamData->funcHandle, i, &inputParaminfo);
+
+    if (inputParaminfo->type == TA_Input_Price) {
+      double *prices[arraysize(priceFlags)] = {nullptr};
+
+      for (int j = 0; j < arraysize(priceFlags); ++j)
+        if (inputParaminfo->flags & priceFlags[j])
+          prices[j] = streamData->columns[column++].data();
+
+      retCode = TA_SetInputParamPricePtr(streamData->funcParams, i, prices[0], prices[1], prices[2], prices[3], prices[4], prices[5]);
+    } else {
+      retCode = TA_SetInputParamRealPtr(streamData->funcParams, i, streamData->columns[column++].data());
+    }
+
+    if (TA_SUCCESS != retCode)
+      return retCode;
+  }
+
+  for (unsigned int i = 0; i < streamData->funcInfo->nbOutput; ++i) {
+    size_t slot = streamData->outSlots[i];
+
+    if (streamData->outIsInteger[i]) {
+      streamData->outIntegers[slot].resize(length);
+      retCode = TA_SetOutputParamIntegerPtr(streamData->funcParams, i, streamData->outIntegers[slot].data());
+    } else {
+      streamData->outReals[slot].resize(length);
+      retCode = TA_SetOutputParamRealPtr(streamData->funcParams, i, streamData->outReals[slot].data());
+    }
+
+    if (TA_SUCCESS != retCode)
+      return retCode;
+  }
+
+  settingsLoad(streamData->settings);
+  return TA_CallFunc(streamData->funcParams, 0, length - 1, outBegIdx, outNBElement);
+}
+
+/* Element of the last TA_CallFunc, blank when negative */
+static double getStreamOutput(const StreamData *streamData, unsigned int index, int element) {
+  size_t slot = streamData->outSlots[index];
+
+  if (streamData->outIsInteger[index])
+    return element >= 0 ? streamData->outIntegers[slot][element] : 0;
+
+  return element >= 0 ? streamData->outReals[slot][element] : NAN;
+}
+
+/* O(history) path, used for functions without a state machine */
+static TA_RetCode recomputeStream(StreamData *streamData) {
+  int outBegIdx, outNBElement, element;
+  int length = (int)streamData->columns[0].size();
+  TA_RetCode retCode;
+
+  if (TA_SUCCESS != (retCode = callStreamFunc(streamData, &outBegIdx, &outNBElement)))
+    return retCode;
+
+  element = outNBElement > 0 && outBegIdx + outNBElement == length ? outNBElement - 1 : -1;
+
+  for (unsigned int i = 0; i < streamData->funcInfo->nbOutput; ++i)
+    streamData->outputs[i] = getStreamOutput(streamData, i, element);
+
+  return TA_SUCCESS;
+}
+
+static void loadStreamBar(StreamData *streamData, size_t index) {
+  for (size_t i = 0; i < streamData->columns.size(); ++i)
+    streamData->bar[i] = streamData->columns[i][index];
+}
+
+/* Replays the history on a fresh state machine and drops it on the first
+ * value that differs from TA_CallFunc */
+static void verifyStream(StreamData *streamData) {
+  int outBegIdx, outNBElement;
+  int length = (int)streamData->columns[0].size();
+  unsigned int nbOutput = streamData->funcInfo->nbOutput;
+  std::vector<double> outputs(nbOutput);
+  bool identical;
+  Stream *stream;
+
+  streamData->verified = true;
+
+  /* The state machine reads the settings it is created with */
+  settingsLoad(streamData->settings);
+  stream = streamCreate(streamData->funcInfo->name, streamData->optInputs.data(), (int)streamData->optInputs.size(), streamData->lookback);
+
+  identical = stream && TA_SUCCESS == callStreamFunc(streamData, &outBegIdx, &outNBElement);
+
+  for (int i = 0; identical && i < length; ++i) {
+    int element = i >= outBegIdx && i < outBegIdx + outNBElement ? i - outBegIdx : -1;
+
+    loadStreamBar(streamData, i);
+    streamUpdate(stream, streamData->bar.data(), outputs.data());
+
+    for (unsigned int j = 0; identical && j < nbOutput; ++j) {
+      double expected = getStreamOutput(streamData, j, element);
+      identical = outputs[j] == expected || (isnan(outputs[j]) && isnan(expected));
+    }
+  }
+
+  if (stream)
+    streamFree(stream);
+
+  if (!identical) {
+    streamFree(streamData->stream);
+    streamData->stream = nullptr;
+    return;
+  }
+
+  /* Later bars only go through the state machine */
+  for (size_t i = 0; i < streamData->columns.size(); ++i)
+    std::vector<double>().swap(streamData->columns[i]);
+
+  for (size_t i = 0; i < streamData->outReals.size(); ++i)
+    std::vector<double>().swap(streamData->outReals[i]);
+
+  for (size_t i = 0; i < streamData->outIntegers.size(); ++i)
+    std::vector<int>().swap(streamData->outIntegers[i]);
+}
+
+static bool keepsStreamHistory(const StreamData *streamData) {
+  return !streamData->verified || !streamData->stream;
+}
+
+static TA_RetCode advanceStream(StreamData *streamData, bool replace) {
+  if (streamData->stream) {
+    if (replace)
+      streamReplaceLast(streamData->stream, streamData->bar.data(), streamData->outputs.data());
+    else
+      streamUpdate(streamData->stream, streamData->bar.data(), streamData->outputs.data());
+
+    if (!streamData->verified && streamData->columns[0].size() >= (size_t)streamData->lookback + STREAM_VERIFY_BARS)
+      verifyStream(streamData);
+
+    if (streamData->stream)
+      return TA_SUCCESS;
+  }
+
+  return recomputeStream(streamData);
+}
+
+static bool parseStreamBar(napi_env env, napi_value value, StreamData *streamData, napi_value *error) {
+  napi_valuetype valuetype;
+
+  CHECK(napi_typeof(env, value, &valuetype));
+
+  /* Functions with a single input take plain numbers */
+  if (valuetype == napi_number && streamData->names.size() == 1) {
+    CHECK(napi_get_value_double(env, value, &streamData->bar[0]));
+    return true;
+  }
+
+  if (valuetype != napi_object) {
+    CHECK(createError(env, "The bar must be a Object", error));
+    return false;
+  }
+
+  for (size_t i = 0; i < streamData->names.size(); ++i) {
+    if (!getNamedPropertyDouble(env, value, streamData->names[i], &streamData->bar[i])) {
+      char errmsg[64] = {0};
+
+      snprintf(errmsg, sizeof(errmsg), "Missing '%s' field", streamData->names[i]);
+      CHECK(createError(env, errmsg, error));
+
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static napi_value generateStreamResult(napi_env env, StreamData *streamData) {
+  napi_value object;
+  const TA_OutputParameterInfo *outputParaminfo;
+
+  CHECK(napi_create_object(env, &object));
+
+  for (unsigned int i = 0; i < streamData->funcInfo->nbOutput; ++i) {
+    TA_GetOutputParameterInfo(streamData->funcHandle, i, &outputParaminfo);
+    CHECK(setNamedPropertyDouble(env, object, outputParaminfo->paramName, streamData->outputs[i]));
+  }
+
+  return object;
+}
+
+static napi_value pushStream(napi_env env, napi_callback_info info, bool replace) {
+  size_t argc = 1;
+  napi_value argv, self, undefined, error;
+  TA_RetCode retCode;
+  StreamData *streamData;
+
+  CHECK(napi_get_cb_info(env, info, &argc, &argv, &self, nullptr));
+  CHECK(napi_get_undefined(env, &undefined));
+
+  if (napi_ok != napi_unwrap(env, self, (void **)&streamData)) {
+    napi_throw_type_error(env, nullptr, "Illegal invocation");
+    return undefined;
+  }
+
+  if (replace && streamData->length == 0) {
+    napi_throw_error(env, nullptr, "There is no bar to replace");
+    return undefined;
+  }
+
+  if (!parseStreamBar(env, argv, streamData, &error)) {
+    CHECK(napi_throw(env, error));
+    return undefined;
+  }
+
+  for (size_t i = 0; keepsStreamHistory(streamData) && i < streamData->columns.size(); ++i) {
+    if (replace)
+      streamData->columns[i].back() = streamData->bar[i];
+    else
+      streamData->columns[i].push_back(streamData->bar[i]);
+  }
+
+  streamData->length += replace ? 0 : 1;
+
+  if (TA_SUCCESS != (retCode = advanceStream(streamData, replace))) {
+    CHECK(createTAError(env, retCode, &error));
+    CHECK(napi_throw(env, error));
+    return undefined;
+  }
+
+  return generateStreamResult(env, streamData);
+}
+
+static napi_value updateStream(napi_env env, napi_callback_info info) {
+  return pushStream(env, info, false);
+}
+
+static napi_value replaceLastStream(napi_env env, napi_callback_info info) {
+  return pushStream(env, info, true);
+}
+
+static bool setupStreamData(napi_env env, const char *funcName, napi_value optInputs, napi_value history, StreamData *streamData, napi_value *error) {
+  TA_RetCode retCode;
+  const FuncLayout *layout;
+  const TA_InputParameterInfo *inputParaminfo;
+  const TA_OutputParameterInfo *outputParaminfo;
+
+  if (TA_SUCCESS != (retCode = getFuncLayout(funcName, &layout)) ||
+      TA_SUCCESS != (retCode = TA_ParamHolderAlloc(layout->funcHandle, &streamData->funcParams))) {
+    CHECK(createTAError(env, retCode, error));
+    return false;
+  }
+
+  streamData->funcHandle = layout->funcHandle;
+  streamData->funcInfo = layout->funcInfo;
+
+  for (unsigned int i = 0; i < streamData->funcInfo->nbInput; ++i) {
+    TA_GetInputParameterInfo(streamData->funcHandle, i, &inputParaminfo);
+
+    switch (inputParaminfo->type) {
+    case TA_Input_Price:
+      for (int j = 0; j < arraysize(priceFlags); ++j)
+        if (inputParaminfo->flags & priceFlags[j])
+          streamData->names.push_back(priceNames[j]);
+      break;
+
+    case TA_Input_Real:
+      streamData->names.push_back(inputParaminfo->paramName);
+      break;
+
+    case TA_Input_Integer:
+      CHECK(createError(env, "Integer inputs are not supported by streams", error));
+      return false;
+    }
+  }
+
+  if (optInputs && !setupOptInputs(env, layout, optInputs, streamData->funcParams, error))
+    return false;
+
+  readOptInputs(env, layout, optInputs, &streamData->optInputs);
+
+  if (TA_SUCCESS != (retCode = getLookback(streamData->settings, streamData->funcParams, &streamData->lookback)) || streamData->lookback < 0) {
+    CHECK(createTAError(env, retCode != TA_SUCCESS ? retCode : TA_BAD_PARAM, error));
+    return false;
+  }
+
+  for (unsigned int i = 0; i < streamData->funcInfo->nbOutput; ++i) {
+    TA_GetOutputParameterInfo(streamData->funcHandle, i, &outputParaminfo);
+
+    streamData->outIsInteger.push_back(outputParaminfo->type == TA_Output_Integer);
+
+    if (outputParaminfo->type == TA_Output_Real) {
+      streamData->outSlots.push_back(streamData->outReals.size());
+      streamData->outReals.emplace_back();
+    } else {
+      streamData->outSlots.push_back(streamData->outIntegers.size());
+      streamData->outIntegers.emplace_back();
+    }
+  }
+
+  streamData->columns.resize(streamData->names.size());
+  streamData->bar.resize(streamData->names.size());
+  streamData->outputs.resize(streamData->funcInfo->nbOutput);
+
+  /* The state machine copies the EMA and RSI settings it depends on */
+  settingsLoad(streamData->settings);
+  streamData->stream = streamCreate(funcName, streamData->optInputs.data(), (int)streamData->optInputs.size(), streamData->lookback);
+
+  if (history) {
+    WorkData workData;
+    std::vector<double *> arrays;
+
+    for (size_t i = 0; i < streamData->names.size(); ++i) {
+      double *array = getNamedPropertyDoubleArray(env, history, streamData->names[i], &workData);
+
+      if (!array) {
+        char errmsg[64] = {0};
+
+        snprintf(errmsg, sizeof(errmsg), "Missing '%s' field", streamData->names[i]);
+        CHECK(createError(env, errmsg, error));
+
+        freeWorkData(env, &workData);
+        return false;
+      }
+
+      arrays.push_back(array);
+    }
+
+    for (size_t i = 0; i < arrays.size(); ++i)
+      streamData->columns[i].assign(arrays[i], arrays[i] + workData.inLength);
+
+    streamData->length = workData.inLength;
+
+    freeWorkData(env, &workData);
+  }
+
+  /* Seeding replays the history once, later bars are O(1) */
+  if (streamData->stream) {
+    for (size_t i = 0; i < streamData->columns[0].size(); ++i) {
+      loadStreamBar(streamData, i);
+      streamUpdate(streamData->stream, streamData->bar.data(), streamData->outputs.data());
+    }
+
+    if (streamData->columns[0].size() >= (size_t)streamData->lookback + STREAM_VERIFY_BARS)
+      verifyStream(streamData);
+  }
+
+  return true;
+}
+
+static napi_value createStream(napi_env env, napi_callback_info info) {
+  size_t argc = 4;
+  napi_value argv[4], undefined, constructor, object, error;
+  napi_value optInputs = nullptr, history = nullptr, settings = nullptr;
+  napi_valuetype valuetype;
+  AddonData *addonData;
+  StreamData *streamData;
+  char funcName[64] = {0};
+
+  CHECK(napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+  CHECK(napi_get_undefined(env, &undefined));
+
+  CHECK(napi_typeof(env, argv[0], &valuetype));
+
+  if (valuetype != napi_string) {
+    napi_throw_type_error(env, nullptr, "The first argument must be a String");
+    return undefined;
+  }
+
+  CHECK(napi_get_value_string_utf8(env, argv[0], funcName, sizeof(funcName), nullptr));
+
+  CHECK(napi_typeof(env, argv[1], &valuetype));
+
+  if (valuetype == napi_object)
+    optInputs = argv[1];
+
+  CHECK(napi_typeof(env, argv[2], &valuetype));
+
+  if (valuetype == napi_object)
+    history = argv[2];
+
+  CHECK(napi_typeof(env, argv[3], &valuetype));
+
+  if (valuetype == napi_object)
+    settings = argv[3];
+
+  streamData = new StreamData();
+
+  if (!parseSettings(env, settings, &streamData->settings, &error) ||
+      !setupStreamData(env, funcName, optInputs, history, streamData, &error)) {
+    freeStreamData(streamData);
+    CHECK(napi_throw(env, error));
+    return undefined;
+  }
+
+  CHECK(napi_get_instance_data(env, (void **)&addonData));
+  CHECK(napi_get_reference_value(env, addonData->streamConstructor, &constructor));
+  CHECK(napi_new_instance(env, constructor, 0, nullptr, &object));
+  CHECK(napi_wrap(env, object, streamData, finalizeStreamData, nullptr, nullptr));
+
+  CHECK(setNamedPropertyString(env, object, "name", streamData->funcInfo->name));
+
+  return object;
+}
+
+static void finalizeFrameData(napi_env env, void *data, void *hint) {
+  delete (FrameData *)data;
+}
+
+/* Reads the values of every column from 'rows', a number appends a single bar */
+static bool parseFrameRows(napi_env env, const std::vector<std::string> &names, napi_value rows, std::vector<std::vector<double>> *values, napi_value *error) {
+  napi_value value;
+  napi_valuetype valuetype;
+  double number;
+  size_t length, count = 0;
+
+  values->resize(names.size());
+
+  for (size_t i = 0; i < names.size(); ++i) {
+    WorkData workData;
+    double *numbers;
+
+    if (!getNamedProperty(env, rows, names[i].c_str(), &value)) {
+      char errmsg[96] = {0};
+
+      snprintf(errmsg, sizeof(errmsg), "Missing '%s' field", names[i].c_str());
+      CHECK(createError(env, errmsg, error));
+
+      return false;
+    }
+
+    CHECK(napi_typeof(env, value, &valuetype));
+
+    if (valuetype == napi_number) {
+      CHECK(napi_get_value_double(env, value, &number));
+      (*values)[i].assign(1, number);
+    } else if ((numbers = marshalDoubleArray(env, value, &workData, &length))) {
+      (*values)[i].assign(numbers, numbers + length);
+    } else {
+      char errmsg[96] = {0};
+
+      snprintf(errmsg, sizeof(errmsg), "Column '%s' must be a number or an array", names[i].c_str());
+      CHECK(createError(env, errmsg, error));
+      freeWorkData(env, &workData);
+
+      return false;
+    }
+
+    freeWorkData(env, &workData);
+
+    if (i > 0 && (*values)[i].size() != count) {
+      CHECK(createError(env, "Columns of a frame need the same length", error));
+      return false;
+    }
+
+    count = (*values)[i].size();
+  }
+
+  return true;
+}
+
+static napi_value appendFrame(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value argv[1], self, undefined, result, error;
+  FrameData *frameData;
+  std::vector<std::vector<double>> values;
+
+  CHECK(napi_get_cb_info(env, info, &argc, argv, &self, nullptr));
+  CHECK(napi_get_undefined(env, &undefined));
+
+  if (!(frameData = getFrameData(env, self))) {
+    napi_throw_type_error(env, nullptr, "Illegal invocation");
+    return undefined;
+  }
+
+  if (frameData->busy > 0) {
+    napi_throw_error(env, nullptr, "Frame is in use by an asynchronous call");
+    return undefined;
+  }
+
+  if (!parseFrameRows(env, frameData->names, argv[0], &values, &error)) {
+    CHECK(napi_throw(env, error));
+    return undefined;
+  }
+
+  for (size_t i = 0; i < values.size(); ++i)
+    frameData->columns[i].insert(frameData->columns[i].end(), values[i].begin(), values[i].end());
+
+  frameData->length += values.size() > 0 ? values[0].size() : 0;
+
+  CHECK(napi_create_int64(env, (int64_t)frameData->length, &result));
+  return result;
+}
+
+static napi_value getFrameLength(napi_env env, napi_callback_info info) {
+  napi_value self, undefined, result;
+  FrameData *frameData;
+
+  CHECK(napi_get_cb_info(env, info, nullptr, nullptr, &self, nullptr));
+  CHECK(napi_get_undefined(env, &undefined));
+
+  if (!(frameData = getFrameData(env, self)))
+    return undefined;
+
+  CHECK(napi_create_int64(env, (int64_t)frameData->length, &result));
+  return result;
+}
+
+static napi_value wrapFrameData(napi_env env, FrameData *frameData) {
+  napi_value constructor, object;
+  AddonData *addonData;
+
+  /* Keeps data() valid for an empty frame */
+  for (auto iter = frameData->columns.begin(); iter != frameData->columns.end(); iter++)
+    iter->reserve(frameData->length > 0 ? frameData->length : 1);
+
+  CHECK(napi_get_instance_data(env, (void **)&addonData));
+  CHECK(napi_get_reference_value(env, addonData->frameConstructor, &constructor));
+  CHECK(napi_new_instance(env, constructor, 0, nullptr, &object));
+  CHECK(napi_wrap(env, object, frameData, finalizeFrameData, nullptr, nullptr));
+
+  return object;
+}
+
+static napi_value createFrame(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value argv[1], undefined, names, key, error;
+  napi_valuetype valuetype;
+  unsigned int count;
+  char name[64];
+  FrameData *frameData;
+  std::vector<std::vector<double>> values;
+
+  CHECK(napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+  CHECK(napi_get_undefined(env, &undefined));
+
+  CHECK(napi_typeof(env, argv[0], &valuetype));
+
+  if (valuetype != napi_object) {
+    napi_throw_type_error(env, nullptr, "The first argument must be a Object");
+    return undefined;
+  }
+
+  CHECK(napi_get_property_names(env, argv[0], &names));
+  CHECK(napi_get_array_length(env, names, &count));
+
+  if (count == 0) {
+    napi_throw_error(env, nullptr, "A frame needs at least one column");
+    return undefined;
+  }
+
+  frameData = new FrameData();
+  frameData->length = 0;
+  frameData->busy = 0;
+
+  for (unsigned int i = 0; i < count; ++i) {
+    CHECK(napi_get_element(env, names, i, &key));
+    CHECK(napi_get_value_string_utf8(env, key, name, sizeof(name), nullptr));
+
+    frameData->names.push_back(name);
+  }
+
+  if (!parseFrameRows(env, frameData->names, argv[0], &values, &error)) {
+    delete frameData;
+    CHECK(napi_throw(env, error));
+    return undefined;
+  }
+
+  frameData->columns.swap(values);
+  frameData->length = frameData->columns[0].size();
+
+  return wrapFrameData(env, frameData);
+}
+
+/* Rows of a resampled frame, folded from base bars as they arrive */
+typedef struct ResamplerData {
+  Resampler *resampler;
+  napi_ref frame;
+  FrameData *frameData;
+  std::vector<std::string> sources;
+  int timeIndex;
+  size_t consumed;
+} ResamplerData;
+
+static void finalizeResamplerData(napi_env env, void *data, void *hint) {
+  ResamplerData *resamplerData = (ResamplerData *)data;
+
+  resamplerFree(resamplerData->resampler);
+  CHECK(napi_delete_reference(env, resamplerData->frame));
+  delete resamplerData;
+}
+
+static ResamplerData *getResamplerData(napi_env env, napi_value value) {
+  napi_value constructor;
+  AddonData *addonData;
+  ResamplerData *resamplerData;
+  bool isResampler;
+
+  CHECK(napi_get_instance_data(env, (void **)&addonData));
+  CHECK(napi_get_reference_value(env, addonData->resamplerConstructor, &constructor));
+  CHECK(napi_instanceof(env, value, constructor, &isResampler));
+
+  if (!isResampler || napi_ok != napi_unwrap(env, value, (void **)&resamplerData))
+    return nullptr;
+
+  return resamplerData;
+}
+
+static const char *resampleRuleNames[] = {"first", "last", "max", "min", "sum"};
+
+static ResampleRule defaultResampleRule(const std::string &name, const char *timeName, bool buckets) {
+  if (name == timeName)
+    return buckets ? RESAMPLE_BUCKET : RESAMPLE_FIRST;
+
+  if (name == "open")
+    return RESAMPLE_FIRST;
+
+  if (name == "high")
+    return RESAMPLE_MAX;
+
+  if (name == "low")
+    return RESAMPLE_MIN;
+
+  if (name == "volume" || name == "openInterest")
+    return RESAMPLE_SUM;
+
+  return RESAMPLE_LAST;
+}
+
+/* 'columns' is a list of names with the OHLCV rules, or names mapped to rules */
+static bool parseResampleColumns(napi_env env, napi_value spec, const char *timeName, bool buckets, std::vector<std::string> *names, std::vector<ResampleRule> *rules, napi_value *error) {
+  napi_value columns, keys, key, value;
+  unsigned int count;
+  char name[64], rule[16];
+  bool isArray;
+
+  if (!getNamedProperty(env, spec, "columns", &columns)) {
+    const char *ohlcv[] = {"open", "high", "low", "close", "volume"};
+
+    if (buckets)
+      names->push_back(timeName);
+
+    names->insert(names->end(), ohlcv, ohlcv + arraysize(ohlcv));
+  } else {
+    CHECK(napi_is_array(env, columns, &isArray));
+
+    if (isArray)
+      keys = columns;
+    else
+      CHECK(napi_get_property_names(env, columns, &keys));
+
+    CHECK(napi_get_array_length(env, keys, &count));
+
+    for (unsigned int i = 0; i < count; ++i) {
+      CHECK(napi_get_element(env, keys, i, &key));
+
+      if (napi_ok != napi_get_value_string_utf8(env, key, name, sizeof(name), nullptr)) {
+        CHECK(createError(env, "Column names must be Strings", error));
+        return false;
+      }
+
+      names->push_back(name);
+    }
+
+    /* The bucket start is always kept */
+    if (buckets && std::find(names->begin(), names->end(), timeName) == names->end())
+      names->insert(names->begin(), timeName);
+
+    if (!isArray) {
+      for (size_t i = 0; i < names->size(); ++i) {
+        rules->push_back(defaultResampleRule((*names)[i], timeName, buckets));
+
+        if (!getNamedProperty(env, columns, (*names)[i].c_str(), &value))
+          continue;
+
+        if (napi_ok != napi_get_value_string_utf8(env, value, rule, sizeof(rule), nullptr) || (buckets && (*names)[i] == timeName)) {
+          CHECK(createError(env, "Column rules must be 'first', 'last', 'max', 'min' or 'sum'", error));
+          return false;
+        }
+
+        int index = 0;
+
+        while (index < arraysize(resampleRuleNames) && strcmp(rule, resampleRuleNames[index]) != 0)
+          index += 1;
+
+        if (index == arraysize(resampleRuleNames)) {
+          CHECK(createError(env, "Column rules must be 'first', 'last', 'max', 'min' or 'sum'", error));
+          return false;
+        }
+
+        rules->back() = (ResampleRule)index;
+      }
+
+      return true;
+    }
+  }
+
+  for (size_t i = 0; i < names->size(); ++i)
+    rules->push_back(defaultResampleRule((*names)[i], timeName, buckets));
+
+  return true;
+}
+
+static napi_value createResampler(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value argv[1], undefined, constructor, object, frame, error;
+  napi_valuetype valuetype;
+  int every = 0;
+  double interval = 0, origin = 0;
+  char timeName[64] = "timestamp";
+  AddonData *addonData;
+  FrameData *frameData;
+  ResamplerData *resamplerData;
+  std::vector<std::string> names;
+  std::vector<ResampleRule> rules;
+
+  CHECK(napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+  CHECK(napi_get_undefined(env, &undefined));
+
+  CHECK(napi_typeof(env, argv[0], &valuetype));
+
+  if (valuetype != napi_object) {
+    napi_throw_type_error(env, nullptr, "The first argument must be a Object");
+    return undefined;
+  }
+
+  getNamedPropertyInt32(env, argv[0], "every", &every);
+  getNamedPropertyDouble(env, argv[0], "interval", &interval);
+  getNamedPropertyDouble(env, argv[0], "origin", &origin);
+  getNamedPropertyString(env, argv[0], "timestamp", timeName, sizeof(timeName));
+
+  if ((every > 0) == (interval > 0)) {
+    napi_throw_range_error(env, nullptr, "Either 'every' or 'interval' needs to be positive");
+    return undefined;
+  }
+
+  if (!isfinite(interval) || !isfinite(origin)) {
+    napi_throw_range_error(env, nullptr, "'interval' and 'origin' need to be finite");
+    return undefined;
+  }
+
+  if (!parseResampleColumns(env, argv[0], timeName, interval > 0, &names, &rules, &error)) {
+    CHECK(napi_throw(env, error));
+    return undefined;
+  }
+
+  if (names.empty()) {
+    napi_throw_error(env, nullptr, "A frame needs at least one column");
+    return undefined;
+  }
+
+  frameData = new FrameData();
+  frameData->names = names;
+  frameData->columns.resize(names.size());
+  frameData->length = 0;
+  frameData->busy = 0;
+  frame = wrapFrameData(env, frameData);
+
+  resamplerData = new ResamplerData();
+  resamplerData->resampler = resamplerCreate(rules.data(), (int)rules.size(), every, interval, origin);
+  resamplerData->frameData = frameData;
+  resamplerData->sources = names;
+  resamplerData->timeIndex = -1;
+  resamplerData->consumed = 0;
+
+  for (size_t i = 0; i < names.size(); ++i)
+    if (interval > 0 && names[i] == timeName)
+      resamplerData->timeIndex = (int)i;
+
+  CHECK(napi_create_reference(env, frame, 1, &resamplerData->frame));
+
+  CHECK(napi_get_instance_data(env, (void **)&addonData));
+  CHECK(napi_get_reference_value(env, addonData->resamplerConstructor, &constructor));
+  CHECK(napi_new_instance(env, constructor, 0, nullptr, &object));
+  CHECK(napi_wrap(env, object, resamplerData, finalizeResamplerData, nullptr, nullptr));
+
+  return object;
+}
+
+/* New base bars come from a frame, from the rows not seen yet, or as columns */
+static bool readResampleBars(napi_env env, ResamplerData *resamplerData, napi_value bars, std::vector<const double *> *inputs, std::vector<std::vector<double>> *values, size_t *count, napi_value *error) {
+  FrameData *source = getFrameData(env, bars);
+
+  inputs->resize(resamplerData->sources.size());
+
+  if (!source) {
+    if (!parseFrameRows(env, resamplerData->sources, bars, values, error))
+      return false;
+
+    for (size_t i = 0; i < values->size(); ++i)
+      (*inputs)[i] = (*values)[i].data();
+
+    *count = values->size() > 0 ? (*values)[0].size() : 0;
+    return true;
+  }
+
+  if (source == resamplerData->frameData) {
+    CHECK(createError(env, "A resampler can not read its own frame", error));
+    return false;
+  }
+
+  /* Frames are read on from where the last update stopped */
+  if (source->length < resamplerData->consumed) {
+    CHECK(createError(env, "The frame is shorter than the bars already read", error));
+    return false;
+  }
+
+  for (size_t i = 0; i < resamplerData->sources.size(); ++i) {
+    size_t column = 0;
+
+    while (column < source->names.size() && source->names[column] != resamplerData->sources[i])
+      column += 1;
+
+    if (column == source->names.size()) {
+      char errmsg[96] = {0};
+
+      snprintf(errmsg, sizeof(errmsg), "Missing '%s' column", resamplerData->sources[i].c_str());
+      CHECK(createError(env, errmsg, error));
+
+      return false;
+    }
+
+    (*inputs)[i] = source->columns[column].data() + resamplerData->consumed;
+  }
+
+  *count = source->length - resamplerData->consumed;
+
+  return true;
+}
+
+static napi_value updateResampler(napi_env env, napi_callback_info info) {
+  size_t argc = 1, count;
+  napi_value argv[1], self, undefined, result, error;
+  ResamplerData *resamplerData;
+  FrameData *frameData;
+  std::vector<const double *> inputs;
+  std::vector<std::vector<double>> values;
+  std::vector<double> bar;
+  const double *row;
+
+  CHECK(napi_get_cb_info(env, info, &argc, argv, &self, nullptr));
+  CHECK(napi_get_undefined(env, &undefined));
+
+  if (!(resamplerData = getResamplerData(env, self))) {
+    napi_throw_type_error(env, nullptr, "Illegal invocation");
+    return undefined;
+  }
+
+  frameData = resamplerData->frameData;
+
+  if (frameData->busy > 0) {
+    napi_throw_error(env, nullptr, "Frame is in use by an asynchronous call");
+    return undefined;
+  }
+
+  if (!readResampleBars(env, resamplerData, argv[0], &inputs, &values, &count, &error)) {
+    CHECK(napi_throw(env, error));
+    return undefined;
+  }
+
+  if (resamplerData->timeIndex >= 0 && !resamplerCheck(resamplerData->resampler, inputs[resamplerData->timeIndex], count)) {
+    napi_throw_range_error(env, nullptr, "Timestamps need to be numbers that do not go back");
+    return undefined;
+  }
+
+  bar.resize(inputs.size());
+
+  for (size_t j = 0; j < count; ++j) {
+    for (size_t i = 0; i < inputs.size(); ++i)
+      bar[i] = inputs[i][j];
+
+    bool opened = resamplerPush(resamplerData->resampler, bar.data(), resamplerData->timeIndex >= 0 ? bar[resamplerData->timeIndex] : 0);
+
+    row = resamplerRow(resamplerData->resampler);
+
+    /* The open row is rewritten in place until the next one starts */
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      if (opened)
+        frameData->columns[i].push_back(row[i]);
+      else
+        frameData->columns[i].back() = row[i];
+    }
+
+    frameData->length += opened ? 1 : 0;
+  }
+
+  /* Bars of a source frame count as read once they are folded */
+  if (getFrameData(env, argv[0]))
+    resamplerData->consumed += count;
+
+  CHECK(napi_create_int64(env, (int64_t)frameData->length, &result));
+  return result;
+}
+
+static napi_value getResamplerFrame(napi_env env, napi_callback_info info) {
+  napi_value self, undefined, frame;
+  ResamplerData *resamplerData;
+
+  CHECK(napi_get_cb_info(env, info, nullptr, nullptr, &self, nullptr));
+  CHECK(napi_get_undefined(env, &undefined));
+
+  if (!(resamplerData = getResamplerData(env, self)))
+    return undefined;
+
+  CHECK(napi_get_reference_value(env, resamplerData->frame, &frame));
+  return frame;
+}
+
+/* Rows whose base bars are all in, the last one may still be forming */
+static napi_value getResamplerComplete(napi_env env, napi_callback_info info) {
+  napi_value self, undefined, result;
+  ResamplerData *resamplerData;
+  size_t length;
+
+  CHECK(napi_get_cb_info(env, info, nullptr, nullptr, &self, nullptr));
+  CHECK(napi_get_undefined(env, &undefined));
+
+  if (!(resamplerData = getResamplerData(env, self)))
+    return undefined;
+
+  length = resamplerData->frameData->length;
+
+  if (length > 0 && !resamplerRowComplete(resamplerData->resampler))
+    length -= 1;
+
+  CHECK(napi_create_int64(env, (int64_t)length, &result));
+  return result;
+}
+
+typedef struct MappedColumns {
+  ColumnFile *file;
+  unsigned int refs;
+} MappedColumns;
+
+static void releaseMappedColumns(MappedColumns *mapped) {
+  if (--mapped->refs == 0) {
+    columnFileClose(mapped->file);
+    delete mapped;
+  }
+}
+
+static void finalizeMappedColumn(napi_env env, void *data, void *hint) {
+  releaseMappedColumns((MappedColumns *)hint);
+}
+
+static bool getPathArgument(napi_env env, napi_value value, std::string *path) {
+  napi_valuetype valuetype;
+  size_t length;
+
+  CHECK(napi_typeof(env, value, &valuetype));
+
+  if (valuetype != napi_string)
+    return false;
+
+  CHECK(napi_get_value_string_utf8(env, value, nullptr, 0, &length));
+  path->resize(length + 1);
+  CHECK(napi_get_value_string_utf8(env, value, &(*path)[0], length + 1, nullptr));
+  path->resize(length);
+
+  return true;
+}
+
+static napi_value mapColumns(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value argv[1], undefined, result, arraybuffer, array;
+  MappedColumns *mapped;
+  ColumnFile *file;
+  const char *errmsg;
+  std::string path;
+  size_t rows;
+
+  CHECK(napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+  CHECK(napi_get_undefined(env, &undefined));
+
+  if (!getPathArgument(env, argv[0], &path)) {
+    napi_throw_type_error(env, nullptr, "The first argument must be a String");
+    return undefined;
+  }
+
+  if (!(file = columnFileOpen(path.c_str(), &errmsg))) {
+    napi_throw_error(env, nullptr, errmsg);
+    return undefined;
+  }
+
+  /* Every array over the mapping holds a reference, the last one unmaps it */
+  mapped = new MappedColumns();
+  mapped->file = file;
+  mapped->refs = 1;
+
+  rows = (size_t)columnFileRows(file);
+
+  CHECK(napi_create_object(env, &result));
+
+  for (uint32_t i = 0; i < columnFileColumns(file); ++i) {
+    const ColumnFileEntry *entry = columnFileEntry(file, i);
+    napi_typedarray_type type = entry->type == COLUMN_INT64 ? napi_bigint64_array : napi_float64_array;
+    void *data = columnFileData(file, i);
+    char name[COLUMN_NAME_SIZE + 1] = {0};
+
+    memcpy(name, entry->name, COLUMN_NAME_SIZE);
+
+    /* Some runtimes (e.g. Electron) do not allow external buffers */
+    if (rows > 0 && napi_ok == napi_create_external_arraybuffer(env, data, sizeof(double) * rows, finalizeMappedColumn, mapped, &arraybuffer)) {
+      mapped->refs += 1;
+      CHECK(napi_create_typedarray(env, type, rows, arraybuffer, 0, &array));
+    } else
+      createCopiedTypedArray(env, type, data, sizeof(double) * rows, rows, &array);
+
+    CHECK(napi_set_named_property(env, result, name, array));
+  }
+
+  releaseMappedColumns(mapped);
+  return result;
+}
+
+static napi_value writeColumns(napi_env env, napi_callback_info info) {
+  size_t argc = 2;
+  napi_value argv[2], undefined, names, key, value;
+  napi_valuetype valuetype;
+  napi_typedarray_type type;
+  unsigned int count;
+  size_t length, rows = 0;
+  void *data;
+  const char *errmsg;
+  std::string path;
+  std::vector<std::string> columnNames;
+  std::vector<const char *> namePtrs;
+  std::vector<ColumnType> types;
+  std::vector<const void *> columns;
+  WorkData workData;
+
+  CHECK(napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+  CHECK(napi_get_undefined(env, &undefined));
+
+  if (!getPathArgument(env, argv[0], &path)) {
+    napi_throw_type_error(env, nullptr, "The first argument must be a String");
+    return undefined;
+  }
+
+  CHECK(napi_typeof(env, argv[1], &valuetype));
+
+  if (valuetype != napi_object) {
+    napi_throw_type_error(env, nullptr, "The second argument must be a Object");
+    return undefined;
+  }
+
+  CHECK(napi_get_property_names(env, argv[1], &names));
+  CHECK(napi_get_array_length(env, names, &count));
+
+  for (unsigned int i = 0; i < count; ++i) {
+    char name[COLUMN_NAME_SIZE + 1] = {0};
+    size_t nameLength;
+
+    CHECK(napi_get_element(env, names, i, &key));
+    CHECK(napi_get_value_string_utf8(env, key, name, sizeof(name), &nameLength));
+    CHECK(napi_get_property(env, argv[1], key, &value));
+
+    if (nameLength >= COLUMN_NAME_SIZE) {
+      napi_throw_error(env, nullptr, "Column names must be shorter than 48 bytes");
+      freeWorkData(env, &workData);
+      return undefined;
+    }
+
+    /* Timestamps stay 64-bit integers, everything else is stored as float64 */
+    if (getTypedArray(env, value, &type, &length, &data) && type == napi_bigint64_array)
+      types.push_back(COLUMN_INT64);
+    else if ((data = marshalDoubleArray(env, value, &workData, &length)))
+      types.push_back(COLUMN_FLOAT64);
+    else {
+      char message[96] = {0};
+
+      snprintf(message, sizeof(message), "Column '%s' must be an array", name);
+      napi_throw_error(env, nullptr, message);
+      freeWorkData(env, &workData);
+
+      return undefined;
+    }
+
+    if (i > 0 && length != rows) {
+      napi_throw_error(env, nullptr, "Columns need the same length");
+      freeWorkData(env, &workData);
+      return undefined;
+    }
+
+    rows = length;
+    columnNames.push_back(name);
+    columns.push_back(data);
+  }
+
+  for (size_t i = 0; i < columnNames.size(); ++i)
+    namePtrs.push_back(columnNames[i].c_str());
+
+  if (!columnFileWrite(path.c_str(), count, namePtrs.data(), types.data(), columns.data(), rows, &errmsg))
+    napi_throw_error(env, nullptr, errmsg);
+
+  freeWorkData(env, &workData);
+  return undefined;
+}
+
+static napi_value lookback(napi_env env, napi_callback_info info) {
+  size_t argc = 3;
+  napi_value argv[3], undefined, result, error;
+  napi_valuetype valuetype;
+  TA_RetCode retCode;
+  const FuncLayout *layout;
+  TA_ParamHolder *funcParams = nullptr;
+  const TaSettings *settings;
+  char funcName[64] = {0};
+  int value;
+
+  CHECK(napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+  CHECK(napi_get_undefined(env, &undefined));
+
+  CHECK(napi_typeof(env, argv[0], &valuetype));
+
+  if (valuetype != napi_string) {
+    napi_throw_type_error(env, nullptr, "The first argument must be a String");
+    return undefined;
+  }
+
+  CHECK(napi_get_value_string_utf8(env, argv[0], funcName, sizeof(funcName), nullptr));
+
+  if (TA_SUCCESS != (retCode = getFuncLayout(funcName, &layout)) ||
+      TA_SUCCESS != (retCode = TA_ParamHolderAlloc(layout->funcHandle, &funcParams))) {
+    CHECK(createTAError(env, retCode, &error));
+    CHECK(napi_throw(env, error));
+    return undefined;
+  }
+
+  CHECK(napi_typeof(env, argv[1], &valuetype));
+
+  if (valuetype == napi_object && !setupOptInputs(env, layout, argv[1], funcParams, &error)) {
+    TA_ParamHolderFree(funcParams);
+    CHECK(napi_throw(env, error));
+    return undefined;
+  }
+
+  CHECK(napi_typeof(env, argv[2], &valuetype));
+
+  if (!parseSettings(env, valuetype == napi_object ? argv[2] : nullptr, &settings, &error)) {
+    TA_ParamHolderFree(funcParams);
+    CHECK(napi_throw(env, error));
+    return undefined;
+  }
+
+  /* Includes the unstable period set for the function */
+  retCode = getLookback(settings, funcParams, &value);
+  TA_ParamHolderFree(funcParams);
+
+  if (TA_SUCCESS != retCode) {
+    CHECK(createTAError(env, retCode, &error));
+    CHECK(napi_throw(env, error));
+    return undefined;
+  }
+
+  CHECK(napi_create_int32(env, value, &result));
+  return result;
 }
 
-static void executeAsyncCallback(napi_env env, void *data) {
-  AsyncWorkData *asyncWorkData = (AsyncWorkData *)data;
-  WorkData *workData = &asyncWorkData->workData;
+static napi_value version(napi_env env, napi_callback_info info) {
+  napi_value value;
+
+  CHECK(napi_create_string_utf8(env, TA_GetVersionString(), NAPI_AUTO_LENGTH, &value));
 
-  workData->retCode = TA_CallFunc(workData->funcParams, workData->startIdx, workData->endIdx, &workData->outBegIdx, &workData->outNBElement);
+  return value;
 }
 
-static void executeAsyncComplete(napi_env env, napi_status status, void *data) {
-  AsyncWorkData *asyncWorkData = (AsyncWorkData *)data;
-  napi_value undefined, callback, argv[2];
+static napi_value simd(napi_env env, napi_callback_info info) {
+  napi_value value;
+
+  CHECK(napi_create_string_utf8(env, kernelIsa(), NAPI_AUTO_LENGTH, &value));
+
+  return value;
+}
+
+static napi_value setExecutorOptions(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value argv, undefined;
+  napi_valuetype valuetype;
+  int threads = 0;
+  bool affinity = false;
 
-  CHECK(status);
+  CHECK(napi_get_cb_info(env, info, &argc, &argv, nullptr, nullptr));
   CHECK(napi_get_undefined(env, &undefined));
-  CHECK(napi_get_reference_value(env, asyncWorkData->cbref, &callback));
 
-  argv[0] = undefined;
+  CHECK(napi_typeof(env, argv, &valuetype));
 
-  if (!generateResult(env, &asyncWorkData->workData, &argv[1])) {
-    argv[0] = argv[1];
-    argv[1] = undefined;
+  if (valuetype != napi_object) {
+    napi_throw_type_error(env, nullptr, "The argument must be a Object");
+    return undefined;
   }
 
-  CHECK(napi_call_function(env, undefined, callback, 2, argv, nullptr));
+  getNamedPropertyInt32(env, argv, "threads", &threads);
+  getNamedPropertyBool(env, argv, "affinity", &affinity);
+
+  if (threads < 0) {
+    napi_throw_range_error(env, nullptr, "Argument 'threads' must be a non-negative Integer");
+    return undefined;
+  }
 
-  CHECK(napi_delete_reference(env, asyncWorkData->cbref));
-  CHECK(napi_delete_async_work(env, asyncWorkData->worker));
+  executorConfigure(threads, affinity);
 
-  freeWorkData(&asyncWorkData->workData);
-  delete asyncWorkData;
+  return undefined;
 }
 
-static napi_value executeAsync(napi_env env, napi_value object, napi_value callback) {
-  napi_value undefined, name, argv[2];
-  AsyncWorkData *asyncWorkData = new AsyncWorkData();
+static napi_value getExecutorStats(napi_env env, napi_callback_info info) {
+  napi_value object;
+  ExecutorStats stats;
+
+  executorGetStats(&stats);
+
+  CHECK(napi_create_object(env, &object));
+
+  CHECK(setNamedPropertyInt32(env, object, "threads", stats.threads));
+  CHECK(setNamedPropertyDouble(env, object, "queued", (double)stats.queued));
+  CHECK(setNamedPropertyDouble(env, object, "maxQueued", (double)stats.maxQueued));
+  CHECK(setNamedPropertyDouble(env, object, "submitted", (double)stats.submitted));
+  CHECK(setNamedPropertyDouble(env, object, "completed", (double)stats.completed));
+  CHECK(setNamedPropertyDouble(env, object, "waitTime", (double)stats.waitTime));
+  CHECK(setNamedPropertyDouble(env, object, "maxWaitTime", (double)stats.maxWaitTime));
+  CHECK(setNamedPropertyDouble(env, object, "runTime", (double)stats.runTime));
+
+  return object;
+}
+
+static napi_value resetExecutorStats(napi_env env, napi_callback_info info) {
+  napi_value undefined;
 
   CHECK(napi_get_undefined(env, &undefined));
 
-  if (!asyncWorkData) {
-    napi_throw_type_error(env, nullptr, "Out of memory");
-    return undefined;
+  executorResetStats();
+
+  return undefined;
+}
+
+static napi_value getPoolStats(napi_env env, napi_callback_info info) {
+  napi_value object;
+  PoolStats stats;
+
+  poolGetStats(&stats);
+
+  CHECK(napi_create_object(env, &object));
+
+  CHECK(setNamedPropertyDouble(env, object, "allocations", (double)stats.allocations));
+  CHECK(setNamedPropertyDouble(env, object, "hits", (double)stats.hits));
+  CHECK(setNamedPropertyDouble(env, object, "misses", (double)stats.misses));
+  CHECK(setNamedPropertyDouble(env, object, "liveBytes", (double)stats.liveBytes));
+  CHECK(setNamedPropertyDouble(env, object, "cachedBytes", (double)stats.cachedBytes));
+  CHECK(setNamedPropertyDouble(env, object, "trimmedBytes", (double)stats.trimmedBytes));
+
+  return object;
+}
+
+static napi_value resetPoolStats(napi_env env, napi_callback_info info) {
+  napi_value undefined;
+
+  CHECK(napi_get_undefined(env, &undefined));
+
+  poolResetStats();
+
+  return undefined;
+}
+
+static napi_value trimPool(napi_env env, napi_callback_info info) {
+  napi_value result;
+
+  CHECK(napi_create_double(env, (double)poolTrim(), &result));
+  return result;
+}
+
+static napi_value createHistogram(napi_env env, const StatsHistogram *histogram) {
+  napi_value object, array, value;
+
+  CHECK(napi_create_object(env, &object));
+  CHECK(napi_create_array_with_length(env, STATS_BUCKETS, &array));
+
+  CHECK(setNamedPropertyDouble(env, object, "count", (double)histogram->count));
+  CHECK(setNamedPropertyDouble(env, object, "sum", histogram->sum));
+
+  for (int i = 0; i < STATS_BUCKETS; ++i) {
+    CHECK(napi_create_double(env, (double)histogram->buckets[i], &value));
+    CHECK(napi_set_element(env, array, i, value));
   }
+  CHECK(napi_set_named_property(env, object, "buckets", array));
 
-  if (!parseWorkData(env, object, &asyncWorkData->workData, &argv[0])) {
-    argv[1] = undefined;
+  return object;
+}
 
-    freeWorkData(&asyncWorkData->workData);
-    delete asyncWorkData;
+typedef struct StatsObject {
+  napi_env env;
+  napi_value functions;
+} StatsObject;
 
-    CHECK(napi_call_function(env, undefined, callback, 2, argv, nullptr));
+static void addFuncStats(const char *funcName, const FuncStats *funcStats, void *data) {
+  StatsObject *statsObject = (StatsObject *)data;
+  napi_env env = statsObject->env;
+  napi_value object;
+
+  CHECK(napi_create_object(env, &object));
+
+  CHECK(setNamedPropertyDouble(env, object, "calls", (double)funcStats->calls));
+  CHECK(setNamedPropertyDouble(env, object, "elements", (double)funcStats->elements));
+  CHECK(setNamedPropertyDouble(env, object, "inputBytes", (double)funcStats->inputBytes));
+  CHECK(napi_set_named_property(env, object, "parse", createHistogram(env, &funcStats->parse)));
+  CHECK(napi_set_named_property(env, object, "compute", createHistogram(env, &funcStats->compute)));
+  CHECK(napi_set_named_property(env, object, "marshal", createHistogram(env, &funcStats->marshal)));
+  CHECK(napi_set_named_property(env, object, "queueWait", createHistogram(env, &funcStats->queueWait)));
+
+  CHECK(napi_set_named_property(env, statsObject->functions, funcName, object));
+}
+
+static napi_value stats(napi_env env, napi_callback_info info) {
+  napi_value object, array, value;
+  StatsObject statsObject;
+
+  CHECK(napi_create_object(env, &object));
+  CHECK(napi_get_boolean(env, statsEnabled(), &value));
+  CHECK(napi_set_named_property(env, object, "enabled", value));
+
+  /* Shared upper bounds of the histogram buckets in microseconds */
+  CHECK(napi_create_array_with_length(env, STATS_BUCKETS, &array));
+
+  for (int i = 0; i < STATS_BUCKETS; ++i) {
+    CHECK(napi_create_double(env, statsBucketBound(i), &value));
+    CHECK(napi_set_element(env, array, i, value));
+  }
+  CHECK(napi_set_named_property(env, object, "buckets", array));
+
+  statsObject.env = env;
+  CHECK(napi_create_object(env, &statsObject.functions));
+
+  statsForEach(addFuncStats, &statsObject);
+  CHECK(napi_set_named_property(env, object, "functions", statsObject.functions));
+
+  return object;
+}
+
+static napi_value resetStats(napi_env env, napi_callback_info info) {
+  napi_value undefined;
+
+  CHECK(napi_get_undefined(env, &undefined));
+
+  statsReset();
+
+  return undefined;
+}
+
+static napi_value setStatsEnabled(napi_env env, napi_callback_info info) {
+  size_t argc = 1;
+  napi_value argv, undefined;
+  napi_valuetype valuetype;
+  bool enabled;
+
+  CHECK(napi_get_cb_info(env, info, &argc, &argv, nullptr, nullptr));
+  CHECK(napi_get_undefined(env, &undefined));
+
+  CHECK(napi_typeof(env, argv, &valuetype));
+
+  if (valuetype != napi_boolean) {
+    napi_throw_type_error(env, nullptr, "The argument must be a Boolean");
     return undefined;
   }
 
-  CHECK(napi_create_reference(env, callback, 1, &asyncWorkData->cbref));
-  CHECK(napi_create_string_utf8(env, "TA-Lib.Worker", NAPI_AUTO_LENGTH, &name));
-  CHECK(napi_create_async_work(env, nullptr, name, executeAsyncCallback, executeAsyncComplete, asyncWorkData, &asyncWorkData->worker));
-  CHECK(napi_queue_async_work(env, asyncWorkData->worker));
+  CHECK(napi_get_value_bool(env, argv, &enabled));
+
+  statsSetEnabled(enabled);
 
   return undefined;
 }
 
-static napi_value execute(napi_env env, napi_callback_info info) {
-  size_t argc = 2;
-  napi_value argv[2], undefined;
+/* Positional entry point of one function, checked against the abstract tables once */
+typedef struct DirectMethod {
+  const DirectEntry *entry;
+  const TA_FuncHandle *funcHandle;
+  const FuncLayout *layout;
+  std::vector<bool> integerInputs;
+  std::vector<double> optDefaults;
+  std::vector<bool> integerOptInputs;
+  std::vector<bool> integerOutputs;
+} DirectMethod;
+
+#define DIRECT_MAX_ARGS 24
+
+static std::vector<DirectMethod> directMethods;
+
+static void setupDirectMethods(void) {
+  int count;
+  const DirectEntry *entries = directEntries(&count);
+  const TA_FuncInfo *funcInfo;
+  const TA_InputParameterInfo *inputParaminfo;
+  const TA_OptInputParameterInfo *optInputParaminfo;
+  const TA_OutputParameterInfo *outputParaminfo;
+
+  for (int i = 0; i < count; ++i) {
+    DirectMethod method;
+
+    method.entry = &entries[i];
+
+    if (TA_SUCCESS != TA_GetFuncHandle(entries[i].name, &method.funcHandle) || TA_SUCCESS != getFuncLayout(entries[i].name, &method.layout))
+      continue;
+
+    TA_GetFuncInfo(method.funcHandle, &funcInfo);
+
+    for (unsigned int j = 0; j < funcInfo->nbInput; ++j) {
+      TA_GetInputParameterInfo(method.funcHandle, j, &inputParaminfo);
+
+      if (inputParaminfo->type != TA_Input_Price) {
+        method.integerInputs.push_back(inputParaminfo->type == TA_Input_Integer);
+        continue;
+      }
+
+      for (int k = 0; k < arraysize(priceFlags); ++k)
+        if (inputParaminfo->flags & priceFlags[k])
+          method.integerInputs.push_back(false);
+    }
+
+    for (unsigned int j = 0; j < funcInfo->nbOptInput; ++j) {
+      TA_GetOptInputParameterInfo(method.funcHandle, j, &optInputParaminfo);
+      method.optDefaults.push_back(optInputParaminfo->defaultValue);
+      method.integerOptInputs.push_back(optInputParaminfo->type == TA_OptInput_IntegerRange || optInputParaminfo->type == TA_OptInput_IntegerList);
+    }
+
+    for (unsigned int j = 0; j < funcInfo->nbOutput; ++j) {
+      TA_GetOutputParameterInfo(method.funcHandle, j, &outputParaminfo);
+      method.integerOutputs.push_back(outputParaminfo->type == TA_Output_Integer);
+    }
+
+    /* A table generated for another TA-Lib version */
+    if ((int)method.integerInputs.size() != entries[i].nbInput ||
+        (int)method.optDefaults.size() != entries[i].nbOptInput ||
+        (int)method.integerOutputs.size() != entries[i].nbOutput ||
+        entries[i].nbInput + entries[i].nbOptInput + 2 > DIRECT_MAX_ARGS)
+      continue;
+
+    directMethods.push_back(method);
+  }
+}
+
+static bool setupDirectSingleInputs(napi_env env, const DirectMethod *method, size_t argc, napi_value *argv, WorkData *workData) {
+  napi_typedarray_type type;
+  size_t length, inLength = workData->inLength;
+  void *data;
+
+  if ((size_t)method->entry->nbInput > argc)
+    return false;
+
+  for (int i = 0; i < method->entry->nbInput; ++i) {
+    if (method->integerInputs[i] || !getTypedArray(env, argv[i], &type, &length, &data) || type != napi_float32_array) {
+      workData->singleInputs.clear();
+      return false;
+    }
+
+    inLength = length < inLength ? length : inLength;
+    workData->singleInputs.push_back((const float *)data);
+  }
+
+  for (int i = 0; i < method->entry->nbInput; ++i)
+    pinValue(env, argv[i], workData);
+
+  workData->inLength = inLength;
+  return true;
+}
+
+static bool setupDirectArgs(napi_env env, const DirectMethod *method, size_t argc, napi_value *argv, WorkData *workData, std::vector<const void *> *inputs, std::vector<double> *optInputs, napi_value *error) {
+  const DirectEntry *entry = method->entry;
   napi_valuetype valuetype;
+  size_t length;
+  char errmsg[64];
+  int index;
 
-  CHECK(napi_get_cb_info(env, info, &argc, argv, nullptr, nullptr));
+  /* Float32Array inputs run the TA_S_* variant without being widened */
+  if (method->layout->singleFunc && setupDirectSingleInputs(env, method, argc, argv, workData))
+    workData->singleFunc = method->layout->singleFunc;
+
+  for (int i = 0; !workData->singleFunc && i < entry->nbInput; ++i) {
+    const void *input = nullptr;
+
+    if ((size_t)i < argc)
+      input = method->integerInputs[i] ? (const void *)marshalInt32Array(env, argv[i], workData, &length)
+                                       : (const void *)marshalDoubleArray(env, argv[i], workData, &length);
+
+    if (!input) {
+      snprintf(errmsg, sizeof(errmsg), "Argument %d must be a Array", i + 1);
+      CHECK(createError(env, errmsg, error));
+      return false;
+    }
+
+    workData->inLength = length < workData->inLength ? length : workData->inLength;
+    (*inputs)[i] = input;
+
+    if (!method->integerInputs[i])
+      workData->realInputs.push_back((const double *)input);
+  }
+
+  /* The same native paths as execute, the thunk is the TA_CallFunc fallback */
+  if (!workData->singleFunc && (int)workData->realInputs.size() == entry->nbInput) {
+    workData->kernel = method->layout->kernel;
+    workData->rolling = method->layout->rolling;
+  }
+
+  /* Missing optInputs take the defaults of the abstract tables */
+  for (int i = 0; i < entry->nbOptInput && (size_t)(index = entry->nbInput + i) < argc; ++i) {
+    CHECK(napi_typeof(env, argv[index], &valuetype));
+
+    if (valuetype == napi_undefined)
+      continue;
+
+    if (valuetype != napi_number) {
+      snprintf(errmsg, sizeof(errmsg), "Argument %d must be a Number", index + 1);
+      CHECK(createError(env, errmsg, error));
+      return false;
+    }
+
+    CHECK(napi_get_value_double(env, argv[index], &(*optInputs)[i]));
+
+    /* Converted to int before TA-Lib sees them */
+    if (method->integerOptInputs[i] && !((*optInputs)[i] >= INT32_MIN && (*optInputs)[i] <= INT32_MAX && (*optInputs)[i] == floor((*optInputs)[i]))) {
+      snprintf(errmsg, sizeof(errmsg), "Argument %d must be a Integer", index + 1);
+      CHECK(createError(env, errmsg, error));
+      return false;
+    }
+  }
+
+  workData->startIdx = 0;
+  workData->endIdx = -1;
+
+  for (int i = 0; i < 2 && (size_t)(index = entry->nbInput + entry->nbOptInput + i) < argc; ++i) {
+    CHECK(napi_typeof(env, argv[index], &valuetype));
+
+    if (valuetype == napi_undefined)
+      continue;
+
+    if (valuetype != napi_number) {
+      snprintf(errmsg, sizeof(errmsg), "Argument %d must be a Integer", index + 1);
+      CHECK(createError(env, errmsg, error));
+      return false;
+    }
+
+    CHECK(napi_get_value_int32(env, argv[index], i == 0 ? &workData->startIdx : &workData->endIdx));
+  }
+
+  if (workData->startIdx < 0) {
+    CHECK(createError(env, "Argument 'startIdx' needs to be positive", error));
+    return false;
+  }
+
+  return checkInputRange(env, workData, error);
+}
+
+/* talib.direct.SMA(inReal, optInTimePeriod, startIdx, endIdx), the same
+ * result as a typed execute without parsing a param object */
+static napi_value callDirect(napi_env env, napi_callback_info info) {
+  size_t argc = DIRECT_MAX_ARGS, outSize;
+  napi_value argv[DIRECT_MAX_ARGS], result, undefined, error;
+  DirectMethod *method;
+  WorkData workData;
+  int64_t startedAt = now();
+
+  CHECK(napi_get_cb_info(env, info, &argc, argv, nullptr, (void **)&method));
   CHECK(napi_get_undefined(env, &undefined));
 
-  CHECK(napi_typeof(env, argv[0], &valuetype));
+  std::vector<const void *> inputs(method->entry->nbInput);
+  std::vector<void *> outputs(method->entry->nbOutput);
 
-  if (valuetype != napi_object) {
-    napi_throw_type_error(env, nullptr, "The first argument must be a Object");
+  workData.funcHandle = (TA_FuncHandle *)method->funcHandle;
+  workData.nbOutput = method->entry->nbOutput;
+  workData.optInputs = method->optDefaults;
+  workData.typed = true;
+
+  if (!setupDirectArgs(env, method, argc, argv, &workData, &inputs, &workData.optInputs, &error)) {
+    freeWorkData(env, &workData);
+    CHECK(napi_throw(env, error));
     return undefined;
   }
 
-  CHECK(napi_typeof(env, argv[1], &valuetype));
+  outSize = workData.endIdx - workData.startIdx + 1;
 
-  return valuetype == napi_function
-             ? executeAsync(env, argv[0], argv[1])
-             : executeSync(env, argv[0]);
+  for (int i = 0; i < method->entry->nbOutput; ++i) {
+    if (method->integerOutputs[i]) {
+      outputs[i] = poolAlloc(sizeof(int) * outSize);
+      workData.outIntegers.push_back((int *)outputs[i]);
+    } else {
+      outputs[i] = poolAlloc(sizeof(double) * outSize);
+      workData.outReals.push_back((double *)outputs[i]);
+    }
+
+    if (!outputs[i]) {
+      freeWorkData(env, &workData);
+      napi_throw_error(env, nullptr, "Out of memory");
+      return undefined;
+    }
+  }
+
+  workData.outArrays.assign(workData.nbOutput, nullptr);
+  workData.outBuffers.assign(workData.nbOutput, nullptr);
+  workData.parseTime = now() - startedAt;
+
+  startedAt = now();
+  settingsLoad(nullptr);
+
+  if (workData.singleFunc)
+    workData.retCode = callSingleFunc(&workData);
+  else if (workData.kernel)
+    workData.retCode = callKernel(&workData);
+  else
+    workData.retCode = callRolling(&workData);
+
+  if (TA_NOT_SUPPORTED == workData.retCode)
+    workData.retCode = method->entry->func(workData.startIdx, workData.endIdx, inputs.data(), workData.optInputs.data(), &workData.outBegIdx, &workData.outNBElement, outputs.data());
+
+  workData.computeTime = now() - startedAt;
+
+  if (!generateResult(env, &workData, &result)) {
+    freeWorkData(env, &workData);
+    CHECK(napi_throw(env, result));
+    return undefined;
+  }
+
+  freeWorkData(env, &workData);
+  return result;
 }
 
-static napi_value version(napi_env env, napi_callback_info info) {
-  napi_value value;
+static void defineDirectMethods(napi_env env, napi_value exports) {
+  napi_value direct;
+  std::vector<napi_property_descriptor> props;
 
-  CHECK(napi_create_string_utf8(env, TA_GetVersionString(), NAPI_AUTO_LENGTH, &value));
+  for (auto iter = directMethods.begin(); iter != directMethods.end(); iter++)
+    props.push_back({iter->entry->name, 0, callDirect, 0, 0, 0, napi_enumerable, &*iter});
 
-  return value;
+  CHECK(napi_create_object(env, &direct));
+  CHECK(napi_define_properties(env, direct, props.size(), props.data()));
+  CHECK(napi_set_named_property(env, exports, "direct", direct));
+}
+
+/* A terminated Worker frees the inputs its tasks read, so they finish first.
+ * Their completions are then dropped by the tsfn teardown. */
+static void drainAddonData(void *data) {
+  AddonData *addonData = (AddonData *)data;
+  std::unique_lock<std::mutex> lock(addonData->mutex);
+
+  addonData->idle.wait(lock, [&] { return addonData->running == 0; });
+}
+
+static void finalizeAddonData(napi_env env, void *data, void *hint) {
+  AddonData *addonData = (AddonData *)data;
+
+  /* The tsfn itself is closed by the environment teardown */
+  CHECK(napi_delete_reference(env, addonData->preparedConstructor));
+  CHECK(napi_delete_reference(env, addonData->streamConstructor));
+  CHECK(napi_delete_reference(env, addonData->frameConstructor));
+  CHECK(napi_delete_reference(env, addonData->resamplerConstructor));
+  delete addonData;
 }
 
+static std::once_flag initialized;
+
 static napi_value init(napi_env env, napi_value exports) {
-  TA_Initialize();
+  napi_value name, constructor;
+  AddonData *addonData = new AddonData();
+
+  /* TA-Lib's tables are immutable and shared by every environment, a second
+   * TA_Initialize would only reset the globals each thread copies */
+  std::call_once(initialized, [] {
+    TA_Initialize();
+    setupFuncLayouts();
+    setupDirectMethods();
+  });
+
+  addonData->pending = 0;
+  addonData->running = 0;
+
+  napi_property_descriptor preparedProps[] = {
+      DECLARE_NAPI_METHOD_("run", runPrepared),
+  };
+  CHECK(napi_define_class(env, "PreparedFunction", NAPI_AUTO_LENGTH, constructInstance, nullptr, arraysize(preparedProps), preparedProps, &constructor));
+  CHECK(napi_create_reference(env, constructor, 1, &addonData->preparedConstructor));
+
+  napi_property_descriptor streamProps[] = {
+      DECLARE_NAPI_METHOD_("update", updateStream),
+      DECLARE_NAPI_METHOD_("replaceLast", replaceLastStream),
+  };
+  CHECK(napi_define_class(env, "StreamIndicator", NAPI_AUTO_LENGTH, constructInstance, nullptr, arraysize(streamProps), streamProps, &constructor));
+  CHECK(napi_create_reference(env, constructor, 1, &addonData->streamConstructor));
+
+  napi_property_descriptor frameProps[] = {
+      DECLARE_NAPI_METHOD_("append", appendFrame),
+      {"length", 0, 0, getFrameLength, 0, 0, napi_default, 0},
+  };
+  CHECK(napi_define_class(env, "Frame", NAPI_AUTO_LENGTH, constructInstance, nullptr, arraysize(frameProps), frameProps, &constructor));
+  CHECK(napi_create_reference(env, constructor, 1, &addonData->frameConstructor));
+
+  napi_property_descriptor resamplerProps[] = {
+      DECLARE_NAPI_METHOD_("update", updateResampler),
+      {"frame", 0, 0, getResamplerFrame, 0, 0, napi_default, 0},
+      {"complete", 0, 0, getResamplerComplete, 0, 0, napi_default, 0},
+  };
+  CHECK(napi_define_class(env, "Resampler", NAPI_AUTO_LENGTH, constructInstance, nullptr, arraysize(resamplerProps), resamplerProps, &constructor));
+  CHECK(napi_create_reference(env, constructor, 1, &addonData->resamplerConstructor));
+
+  /* One tsfn per environment delivers every executor completion back to JS */
+  CHECK(napi_create_string_utf8(env, "TA-Lib.Executor", NAPI_AUTO_LENGTH, &name));
+  CHECK(napi_create_threadsafe_function(env, nullptr, nullptr, name, 0, 1, nullptr, nullptr, addonData, completeAsyncTask, &addonData->tsfn));
+  CHECK(napi_unref_threadsafe_function(env, addonData->tsfn));
+  CHECK(napi_set_instance_data(env, addonData, finalizeAddonData, nullptr));
+
+  /* Hooks run in reverse order, so this one runs before the tsfn is closed */
+  CHECK(napi_add_env_cleanup_hook(env, drainAddonData, addonData));
 
   napi_property_descriptor props[] = {
       DECLARE_NAPI_METHOD(getFunctionGroups),
@@ -1028,12 +6139,43 @@ static napi_value init(napi_env env, napi_value exports) {
       DECLARE_NAPI_METHOD(setUnstablePeriod),
       DECLARE_NAPI_METHOD(setCompatibility),
       DECLARE_NAPI_METHOD(explain),
+      DECLARE_NAPI_METHOD(lookback),
       DECLARE_NAPI_METHOD(execute),
+      DECLARE_NAPI_METHOD(executeBatch),
+      DECLARE_NAPI_METHOD(executeUniverse),
+      DECLARE_NAPI_METHOD(executeSweep),
+      DECLARE_NAPI_METHOD_("executeAsync", executePromise),
+      DECLARE_NAPI_METHOD_("executeBatchAsync", executeBatchPromise),
+      DECLARE_NAPI_METHOD_("executeUniverseAsync", executeUniversePromise),
+      DECLARE_NAPI_METHOD_("executeSweepAsync", executeSweepPromise),
+      DECLARE_NAPI_METHOD(executePipeline),
+      DECLARE_NAPI_METHOD(scanCandles),
+      DECLARE_NAPI_METHOD(prepare),
+      DECLARE_NAPI_METHOD_("stream", createStream),
+      DECLARE_NAPI_METHOD_("frame", createFrame),
+      DECLARE_NAPI_METHOD_("resample", createResampler),
+      DECLARE_NAPI_METHOD(mapColumns),
+      DECLARE_NAPI_METHOD(writeColumns),
+      DECLARE_NAPI_METHOD(setExecutorOptions),
+      DECLARE_NAPI_METHOD(getExecutorStats),
+      DECLARE_NAPI_METHOD(resetExecutorStats),
+      DECLARE_NAPI_METHOD(getPoolStats),
+      DECLARE_NAPI_METHOD(resetPoolStats),
+      DECLARE_NAPI_METHOD(trimPool),
+      DECLARE_NAPI_METHOD(stats),
+      DECLARE_NAPI_METHOD(resetStats),
+      DECLARE_NAPI_METHOD(setStatsEnabled),
       DECLARE_NAPI_METHOD(version),
+      DECLARE_NAPI_METHOD(simd),
   };
   CHECK(napi_define_properties(env, exports, arraysize(props), props));
 
+  defineDirectMethods(env, exports);
+
   return exports;
 }
 
-NAPI_MODULE(NODE_GYP_MODULE_NAME, init)
+/* Context-aware, each worker_threads Worker gets its own exports */
+NAPI_MODULE_INIT() {
+  return init(env, exports);
+}
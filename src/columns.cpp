@@ -0,0 +1,229 @@
+/*
+ * columns.cpp
+ *
+ * Copyright (c) 2024-2025 Xiongfei Shi
+ *
+ * Author: Xiongfei Shi <xiongfei.shi(a)icloud.com>
+ * License: Apache-2.0
+ *
+ * https://github.com/shixiongfei/napi-talib
+ */
+
+#include "columns.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+struct ColumnFile {
+  void *base;
+  size_t size;
+  const ColumnFileHeader *header;
+  const ColumnFileEntry *entries;
+#if defined(_WIN32)
+  HANDLE mapping;
+#endif
+};
+
+static bool mapFile(ColumnFile *file, const char *path) {
+#if defined(_WIN32)
+  HANDLE handle;
+  LARGE_INTEGER size;
+
+  handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+  if (handle == INVALID_HANDLE_VALUE)
+    return false;
+
+  if (!GetFileSizeEx(handle, &size) || size.QuadPart == 0) {
+    CloseHandle(handle);
+    return false;
+  }
+
+  file->size = (size_t)size.QuadPart;
+  file->mapping = CreateFileMappingA(handle, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+  CloseHandle(handle);
+
+  if (!file->mapping)
+    return false;
+
+  if (!(file->base = MapViewOfFile(file->mapping, FILE_MAP_COPY, 0, 0, 0))) {
+    CloseHandle(file->mapping);
+    return false;
+  }
+
+  return true;
+#else
+  struct stat st;
+  int fd;
+
+  if ((fd = open(path, O_RDONLY)) < 0)
+    return false;
+
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    close(fd);
+    return false;
+  }
+
+  /* Private and writable, so typed arrays over it can be written without a fault */
+  file->size = (size_t)st.st_size;
+  file->base = mmap(nullptr, file->size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+
+  return file->base != MAP_FAILED;
+#endif
+}
+
+static void unmapFile(ColumnFile *file) {
+#if defined(_WIN32)
+  UnmapViewOfFile(file->base);
+  CloseHandle(file->mapping);
+#else
+  munmap(file->base, file->size);
+#endif
+}
+
+ColumnFile *columnFileOpen(const char *path, const char **error) {
+  ColumnFile *file = new ColumnFile();
+  const ColumnFileHeader *header;
+  size_t directory;
+
+  if (!mapFile(file, path)) {
+    *error = "Cannot map the column file";
+    delete file;
+    return nullptr;
+  }
+
+  header = (const ColumnFileHeader *)file->base;
+  directory = sizeof(ColumnFileHeader);
+
+  if (file->size < directory || memcmp(header->magic, COLUMN_FILE_MAGIC, sizeof(header->magic)) != 0) {
+    *error = "Not a column file";
+    goto failed;
+  }
+
+  if (header->version != COLUMN_FILE_VERSION) {
+    *error = "Unsupported column file version";
+    goto failed;
+  }
+
+  directory += sizeof(ColumnFileEntry) * header->nbColumns;
+
+  if (file->size < directory || header->nbRows > (file->size - directory) / sizeof(double)) {
+    *error = "Column file is truncated";
+    goto failed;
+  }
+
+  file->header = header;
+  file->entries = (const ColumnFileEntry *)((const char *)file->base + sizeof(ColumnFileHeader));
+
+  for (uint32_t i = 0; i < header->nbColumns; ++i) {
+    const ColumnFileEntry *entry = &file->entries[i];
+
+    if (entry->type != COLUMN_FLOAT64 && entry->type != COLUMN_INT64) {
+      *error = "Unsupported column type";
+      goto failed;
+    }
+
+    /* Typed arrays need their offset aligned to the element size */
+    if (entry->offset % sizeof(double) != 0 || entry->offset < directory ||
+        entry->offset > file->size || header->nbRows > (file->size - entry->offset) / sizeof(double)) {
+      *error = "Column file is truncated";
+      goto failed;
+    }
+  }
+
+  return file;
+
+failed:
+  unmapFile(file);
+  delete file;
+  return nullptr;
+}
+
+void columnFileClose(ColumnFile *file) {
+  unmapFile(file);
+  delete file;
+}
+
+uint64_t columnFileRows(const ColumnFile *file) {
+  return file->header->nbRows;
+}
+
+uint32_t columnFileColumns(const ColumnFile *file) {
+  return file->header->nbColumns;
+}
+
+const ColumnFileEntry *columnFileEntry(const ColumnFile *file, uint32_t index) {
+  return &file->entries[index];
+}
+
+void *columnFileData(const ColumnFile *file, uint32_t index) {
+  return (char *)file->base + file->entries[index].offset;
+}
+
+static size_t alignOffset(size_t offset) {
+  return (offset + COLUMN_FILE_ALIGN - 1) / COLUMN_FILE_ALIGN * COLUMN_FILE_ALIGN;
+}
+
+bool columnFileWrite(const char *path, uint32_t nbColumns, const char *const *names, const ColumnType *types, const void *const *columns, uint64_t nbRows, const char **error) {
+  static const char padding[COLUMN_FILE_ALIGN] = {0};
+  ColumnFileHeader header;
+  ColumnFileEntry entry;
+  size_t offset, position;
+  bool succeeded = true;
+  FILE *fp;
+
+  if (!(fp = fopen(path, "wb"))) {
+    *error = "Cannot create the column file";
+    return false;
+  }
+
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, COLUMN_FILE_MAGIC, sizeof(header.magic));
+  header.version = COLUMN_FILE_VERSION;
+  header.nbColumns = nbColumns;
+  header.nbRows = nbRows;
+
+  succeeded = succeeded && fwrite(&header, sizeof(header), 1, fp) == 1;
+
+  position = sizeof(header) + sizeof(ColumnFileEntry) * nbColumns;
+  offset = alignOffset(position);
+
+  for (uint32_t i = 0; i < nbColumns; ++i) {
+    memset(&entry, 0, sizeof(entry));
+    snprintf(entry.name, sizeof(entry.name), "%s", names[i]);
+    entry.type = types[i];
+    entry.offset = offset;
+
+    succeeded = succeeded && fwrite(&entry, sizeof(entry), 1, fp) == 1;
+    offset = alignOffset(offset + sizeof(double) * nbRows);
+  }
+
+  for (uint32_t i = 0; i < nbColumns && succeeded; ++i) {
+    size_t next = alignOffset(position);
+
+    succeeded = fwrite(padding, 1, next - position, fp) == next - position &&
+                (nbRows == 0 || fwrite(columns[i], sizeof(double), nbRows, fp) == nbRows);
+
+    position = next + sizeof(double) * nbRows;
+  }
+
+  if (fclose(fp) != 0 || !succeeded) {
+    *error = "Cannot write the column file";
+    return false;
+  }
+
+  return true;
+}
@@ -0,0 +1,60 @@
+/*
+ * columns.h
+ *
+ * Copyright (c) 2024-2025 Xiongfei Shi
+ *
+ * Author: Xiongfei Shi <xiongfei.shi(a)icloud.com>
+ * License: Apache-2.0
+ *
+ * https://github.com/shixiongfei/napi-talib
+ */
+
+#ifndef NAPI_TALIB_COLUMNS_H
+#define NAPI_TALIB_COLUMNS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Columnar file, in host byte order:
+ *   ColumnFileHeader, then nbColumns ColumnFileEntry,
+ *   then each column at its offset (COLUMN_FILE_ALIGN aligned), nbRows values. */
+#define COLUMN_FILE_MAGIC "TALIBCOL"
+#define COLUMN_FILE_VERSION 1
+#define COLUMN_FILE_ALIGN 64
+#define COLUMN_NAME_SIZE 48
+
+typedef enum ColumnType {
+  COLUMN_FLOAT64 = 0,
+  COLUMN_INT64 = 1,
+} ColumnType;
+
+typedef struct ColumnFileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t nbColumns;
+  uint64_t nbRows;
+} ColumnFileHeader;
+
+typedef struct ColumnFileEntry {
+  char name[COLUMN_NAME_SIZE];
+  uint32_t type;
+  uint32_t reserved;
+  uint64_t offset;
+} ColumnFileEntry;
+
+typedef struct ColumnFile ColumnFile;
+
+/* Map a column file copy-on-write, the pages are shared through the page
+ * cache until written. Returns nullptr and sets error on failure. */
+ColumnFile *columnFileOpen(const char *path, const char **error);
+void columnFileClose(ColumnFile *file);
+
+uint64_t columnFileRows(const ColumnFile *file);
+uint32_t columnFileColumns(const ColumnFile *file);
+const ColumnFileEntry *columnFileEntry(const ColumnFile *file, uint32_t index);
+void *columnFileData(const ColumnFile *file, uint32_t index);
+
+/* Write nbColumns columns of nbRows 8-byte values */
+bool columnFileWrite(const char *path, uint32_t nbColumns, const char *const *names, const ColumnType *types, const void *const *columns, uint64_t nbRows, const char **error);
+
+#endif
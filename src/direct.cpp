@@ -0,0 +1,141 @@
+/*
+ * direct.cpp
+ *
+ * Copyright (c) 2024-2025 Xiongfei Shi
+ *
+ * Author: Xiongfei Shi <xiongfei.shi(a)icloud.com>
+ * License: Apache-2.0
+ *
+ * https://github.com/shixiongfei/napi-talib
+ */
+
+#include "direct.h"
+#include <stddef.h>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+typedef enum DirectKind {
+  DIRECT_INPUT,
+  DIRECT_OPT_INPUT,
+  DIRECT_OUT_INDEX,
+  DIRECT_OUTPUT,
+} DirectKind;
+
+/* 'const double inReal[]' is an input, 'int optInTimePeriod' an optInput and
+ * 'double outReal[]' an output. Every 'int *' starts as an output index, see
+ * DirectLayout::kindAt. */
+template <typename T>
+static constexpr DirectKind directKind() {
+  if constexpr (std::is_same_v<T, const double *> || std::is_same_v<T, const int *>)
+    return DIRECT_INPUT;
+  else if constexpr (std::is_same_v<T, int> || std::is_same_v<T, double> || std::is_same_v<T, TA_MAType>)
+    return DIRECT_OPT_INPUT;
+  else if constexpr (std::is_same_v<T, int *>)
+    return DIRECT_OUT_INDEX;
+  else if constexpr (std::is_same_v<T, double *>)
+    return DIRECT_OUTPUT;
+  else
+    static_assert(sizeof(T) == 0, "Unexpected TA-Lib parameter type");
+}
+
+template <typename... Args>
+struct DirectLayout {
+  static constexpr int count = sizeof...(Args);
+  static constexpr DirectKind kinds[count + 1] = {directKind<Args>()..., DIRECT_INPUT};
+
+  /* The first two 'int *' are outBegIdx and outNBElement, later ones are
+   * integer outputs */
+  static constexpr DirectKind kindAt(int index) {
+    int n = 0;
+
+    if (kinds[index] != DIRECT_OUT_INDEX)
+      return kinds[index];
+
+    for (int i = 0; i < index; ++i)
+      n += kinds[i] == DIRECT_OUT_INDEX ? 1 : 0;
+
+    return n < 2 ? DIRECT_OUT_INDEX : DIRECT_OUTPUT;
+  }
+
+  /* Position among the parameters of the same kind */
+  static constexpr int slotAt(int index) {
+    int n = 0;
+
+    for (int i = 0; i < index; ++i)
+      n += kindAt(i) == kindAt(index) ? 1 : 0;
+
+    return n;
+  }
+
+  static constexpr int countOf(DirectKind kind) {
+    int n = 0;
+
+    for (int i = 0; i < count; ++i)
+      n += kindAt(i) == kind ? 1 : 0;
+
+    return n;
+  }
+};
+
+typedef struct DirectArgs {
+  const void *const *inputs;
+  const double *optInputs;
+  int *outIndex[2];
+  void *const *outputs;
+} DirectArgs;
+
+template <typename Layout, typename T, int I>
+static inline T directArg(const DirectArgs *args) {
+  constexpr DirectKind kind = Layout::kindAt(I);
+  constexpr int slot = Layout::slotAt(I);
+
+  if constexpr (kind == DIRECT_INPUT)
+    return (T)args->inputs[slot];
+  else if constexpr (kind == DIRECT_OPT_INPUT && std::is_same_v<T, double>)
+    return args->optInputs[slot];
+  else if constexpr (kind == DIRECT_OPT_INPUT)
+    return (T)(int)args->optInputs[slot];
+  else if constexpr (kind == DIRECT_OUT_INDEX)
+    return args->outIndex[slot];
+  else
+    return (T)args->outputs[slot];
+}
+
+template <auto F>
+struct DirectThunk;
+
+/* One instance per function, the arguments are unpacked at compile time and
+ * TA_<name> is called directly */
+template <typename... Args, TA_RetCode (*F)(int, int, Args...)>
+struct DirectThunk<F> {
+  typedef DirectLayout<Args...> Layout;
+
+  template <size_t... I>
+  static inline TA_RetCode invoke(int startIdx, int endIdx, const DirectArgs *args, std::index_sequence<I...>) {
+    return F(startIdx, endIdx, directArg<Layout, std::tuple_element_t<I, std::tuple<Args...>>, (int)I>(args)...);
+  }
+
+  static TA_RetCode call(int startIdx, int endIdx, const void *const *inputs, const double *optInputs, int *outBegIdx, int *outNBElement, void *const *outputs) {
+    DirectArgs args = {inputs, optInputs, {outBegIdx, outNBElement}, outputs};
+
+    return invoke(startIdx, endIdx, &args, std::index_sequence_for<Args...>());
+  }
+
+  static constexpr int nbInput = Layout::countOf(DIRECT_INPUT);
+  static constexpr int nbOptInput = Layout::countOf(DIRECT_OPT_INPUT);
+  static constexpr int nbOutput = Layout::countOf(DIRECT_OUTPUT);
+};
+
+#define DIRECT(name) {#name, DirectThunk<TA_##name>::call, DirectThunk<TA_##name>::nbInput, DirectThunk<TA_##name>::nbOptInput, DirectThunk<TA_##name>::nbOutput},
+
+static const DirectEntry entries[] = {
+#include "direct_table.h"
+};
+
+#undef DIRECT
+
+const DirectEntry *directEntries(int *count) {
+  *count = (int)(sizeof(entries) / sizeof(entries[0]));
+  return entries;
+}
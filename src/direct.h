@@ -0,0 +1,34 @@
+/*
+ * direct.h
+ *
+ * Copyright (c) 2024-2025 Xiongfei Shi
+ *
+ * Author: Xiongfei Shi <xiongfei.shi(a)icloud.com>
+ * License: Apache-2.0
+ *
+ * https://github.com/shixiongfei/napi-talib
+ */
+
+#ifndef NAPI_TALIB_DIRECT_H
+#define NAPI_TALIB_DIRECT_H
+
+#include "ta_func.h"
+
+/* Inputs follow the TA-Lib inputs with prices expanded in open, high, low,
+ * close, volume, openInterest order, each one a double or int array as the
+ * function declares it. optInputs and outputs are in TA-Lib order. */
+typedef TA_RetCode (*DirectFunc)(int startIdx, int endIdx, const void *const *inputs, const double *optInputs, int *outBegIdx, int *outNBElement, void *const *outputs);
+
+typedef struct DirectEntry {
+  const char *name;
+  DirectFunc func;
+  int nbInput;
+  int nbOptInput;
+  int nbOutput;
+} DirectEntry;
+
+/* Calls TA_<name> without going through the abstract interface, sorted by
+ * name and generated from the abstract tables by gencodes.js */
+const DirectEntry *directEntries(int *count);
+
+#endif
@@ -0,0 +1,162 @@
+/* This file is automatically generated by gencodes.js */
+DIRECT(ACCBANDS)
+DIRECT(ACOS)
+DIRECT(AD)
+DIRECT(ADD)
+DIRECT(ADOSC)
+DIRECT(ADX)
+DIRECT(ADXR)
+DIRECT(APO)
+DIRECT(AROON)
+DIRECT(AROONOSC)
+DIRECT(ASIN)
+DIRECT(ATAN)
+DIRECT(ATR)
+DIRECT(AVGDEV)
+DIRECT(AVGPRICE)
+DIRECT(BBANDS)
+DIRECT(BETA)
+DIRECT(BOP)
+DIRECT(CCI)
+DIRECT(CDL2CROWS)
+DIRECT(CDL3BLACKCROWS)
+DIRECT(CDL3INSIDE)
+DIRECT(CDL3LINESTRIKE)
+DIRECT(CDL3OUTSIDE)
+DIRECT(CDL3STARSINSOUTH)
+DIRECT(CDL3WHITESOLDIERS)
+DIRECT(CDLABANDONEDBABY)
+DIRECT(CDLADVANCEBLOCK)
+DIRECT(CDLBELTHOLD)
+DIRECT(CDLBREAKAWAY)
+DIRECT(CDLCLOSINGMARUBOZU)
+DIRECT(CDLCONCEALBABYSWALL)
+DIRECT(CDLCOUNTERATTACK)
+DIRECT(CDLDARKCLOUDCOVER)
+DIRECT(CDLDOJI)
+DIRECT(CDLDOJISTAR)
+DIRECT(CDLDRAGONFLYDOJI)
+DIRECT(CDLENGULFING)
+DIRECT(CDLEVENINGDOJISTAR)
+DIRECT(CDLEVENINGSTAR)
+DIRECT(CDLGAPSIDESIDEWHITE)
+DIRECT(CDLGRAVESTONEDOJI)
+DIRECT(CDLHAMMER)
+DIRECT(CDLHANGINGMAN)
+DIRECT(CDLHARAMI)
+DIRECT(CDLHARAMICROSS)
+DIRECT(CDLHIGHWAVE)
+DIRECT(CDLHIKKAKE)
+DIRECT(CDLHIKKAKEMOD)
+DIRECT(CDLHOMINGPIGEON)
+DIRECT(CDLIDENTICAL3CROWS)
+DIRECT(CDLINNECK)
+DIRECT(CDLINVERTEDHAMMER)
+DIRECT(CDLKICKING)
+DIRECT(CDLKICKINGBYLENGTH)
+DIRECT(CDLLADDERBOTTOM)
+DIRECT(CDLLONGLEGGEDDOJI)
+DIRECT(CDLLONGLINE)
+DIRECT(CDLMARUBOZU)
+DIRECT(CDLMATCHINGLOW)
+DIRECT(CDLMATHOLD)
+DIRECT(CDLMORNINGDOJISTAR)
+DIRECT(CDLMORNINGSTAR)
+DIRECT(CDLONNECK)
+DIRECT(CDLPIERCING)
+DIRECT(CDLRICKSHAWMAN)
+DIRECT(CDLRISEFALL3METHODS)
+DIRECT(CDLSEPARATINGLINES)
+DIRECT(CDLSHOOTINGSTAR)
+DIRECT(CDLSHORTLINE)
+DIRECT(CDLSPINNINGTOP)
+DIRECT(CDLSTALLEDPATTERN)
+DIRECT(CDLSTICKSANDWICH)
+DIRECT(CDLTAKURI)
+DIRECT(CDLTASUKIGAP)
+DIRECT(CDLTHRUSTING)
+DIRECT(CDLTRISTAR)
+DIRECT(CDLUNIQUE3RIVER)
+DIRECT(CDLUPSIDEGAP2CROWS)
+DIRECT(CDLXSIDEGAP3METHODS)
+DIRECT(CEIL)
+DIRECT(CMO)
+DIRECT(CORREL)
+DIRECT(COS)
+DIRECT(COSH)
+DIRECT(DEMA)
+DIRECT(DIV)
+DIRECT(DX)
+DIRECT(EMA)
+DIRECT(EXP)
+DIRECT(FLOOR)
+DIRECT(HT_DCPERIOD)
+DIRECT(HT_DCPHASE)
+DIRECT(HT_PHASOR)
+DIRECT(HT_SINE)
+DIRECT(HT_TRENDLINE)
+DIRECT(HT_TRENDMODE)
+DIRECT(IMI)
+DIRECT(KAMA)
+DIRECT(LINEARREG)
+DIRECT(LINEARREG_ANGLE)
+DIRECT(LINEARREG_INTERCEPT)
+DIRECT(LINEARREG_SLOPE)
+DIRECT(LN)
+DIRECT(LOG10)
+DIRECT(MA)
+DIRECT(MACD)
+DIRECT(MACDEXT)
+DIRECT(MACDFIX)
+DIRECT(MAMA)
+DIRECT(MAVP)
+DIRECT(MAX)
+DIRECT(MAXINDEX)
+DIRECT(MEDPRICE)
+DIRECT(MFI)
+DIRECT(MIDPOINT)
+DIRECT(MIDPRICE)
+DIRECT(MIN)
+DIRECT(MININDEX)
+DIRECT(MINMAX)
+DIRECT(MINMAXINDEX)
+DIRECT(MINUS_DI)
+DIRECT(MINUS_DM)
+DIRECT(MOM)
+DIRECT(MULT)
+DIRECT(NATR)
+DIRECT(OBV)
+DIRECT(PLUS_DI)
+DIRECT(PLUS_DM)
+DIRECT(PPO)
+DIRECT(ROC)
+DIRECT(ROCP)
+DIRECT(ROCR)
+DIRECT(ROCR100)
+DIRECT(RSI)
+DIRECT(SAR)
+DIRECT(SAREXT)
+DIRECT(SIN)
+DIRECT(SINH)
+DIRECT(SMA)
+DIRECT(SQRT)
+DIRECT(STDDEV)
+DIRECT(STOCH)
+DIRECT(STOCHF)
+DIRECT(STOCHRSI)
+DIRECT(SUB)
+DIRECT(SUM)
+DIRECT(T3)
+DIRECT(TAN)
+DIRECT(TANH)
+DIRECT(TEMA)
+DIRECT(TRANGE)
+DIRECT(TRIMA)
+DIRECT(TRIX)
+DIRECT(TSF)
+DIRECT(TYPPRICE)
+DIRECT(ULTOSC)
+DIRECT(VAR)
+DIRECT(WCLPRICE)
+DIRECT(WILLR)
+DIRECT(WMA)
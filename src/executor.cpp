@@ -0,0 +1,366 @@
+/*
+ * executor.cpp
+ *
+ * Copyright (c) 2024-2025 Xiongfei Shi
+ *
+ * Author: Xiongfei Shi <xiongfei.shi(a)icloud.com>
+ * License: Apache-2.0
+ *
+ * https://github.com/shixiongfei/napi-talib
+ */
+
+#include "executor.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+typedef struct ForLoop {
+  ExecutorCallback callback;
+  void *data;
+  int grain;
+  bool detached;
+  bool finished;
+  std::atomic<int> remaining;
+  std::mutex mutex;
+  std::condition_variable done;
+
+  ForLoop(ExecutorCallback cb, void *d, int g, int count, bool detach) : remaining(count) {
+    callback = cb;
+    data = d;
+    grain = g > 0 ? g : 1;
+    detached = detach;
+    finished = false;
+  }
+} ForLoop;
+
+typedef struct Task {
+  ForLoop *loop;
+  int begin;
+  int end;
+  int64_t queuedAt;
+} Task;
+
+typedef struct TaskQueue {
+  std::mutex mutex;
+  std::deque<Task> tasks;
+} TaskQueue;
+
+typedef struct Executor {
+  std::vector<TaskQueue *> queues;
+  std::vector<std::thread> threads;
+  TaskQueue injected;
+  std::atomic<int64_t> pending;
+  std::atomic<int> nbThread;
+  std::atomic<bool> started;
+  std::mutex configMutex;
+  std::mutex mutex;
+  std::condition_variable wakeup;
+  bool stopping;
+  bool affinity;
+
+  std::atomic<int64_t> maxQueued;
+  std::atomic<int64_t> submitted;
+  std::atomic<int64_t> completed;
+  std::atomic<int64_t> waitTime;
+  std::atomic<int64_t> maxWaitTime;
+  std::atomic<int64_t> runTime;
+
+  Executor() : pending(0), nbThread(0), started(false), maxQueued(0), submitted(0), completed(0), waitTime(0), maxWaitTime(0), runTime(0) {
+    stopping = false;
+    affinity = false;
+  }
+
+  ~Executor();
+} Executor;
+
+static Executor executor;
+static thread_local int workerIndex = -1;
+
+static int64_t now(void) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void updateMax(std::atomic<int64_t> &maxValue, int64_t value) {
+  int64_t current = maxValue;
+
+  while (value > current && !maxValue.compare_exchange_weak(current, value))
+    ;
+}
+
+static void pushTask(TaskQueue *queue, Task task) {
+  task.queuedAt = now();
+
+  {
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    queue->tasks.push_back(task);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(executor.mutex);
+    updateMax(executor.maxQueued, ++executor.pending);
+  }
+
+  executor.submitted++;
+  executor.wakeup.notify_one();
+}
+
+static bool takeTask(TaskQueue *queue, bool back, Task *task) {
+  std::lock_guard<std::mutex> lock(queue->mutex);
+
+  if (queue->tasks.empty())
+    return false;
+
+  if (back) {
+    *task = queue->tasks.back();
+    queue->tasks.pop_back();
+  } else {
+    *task = queue->tasks.front();
+    queue->tasks.pop_front();
+  }
+
+  executor.pending--;
+  return true;
+}
+
+static bool popTask(Task *task) {
+  int count = (int)executor.queues.size();
+  int self = workerIndex;
+
+  /* Own queue is LIFO to stay cache warm, thieves take the oldest (largest) ranges */
+  if (self >= 0 && takeTask(executor.queues[self], true, task))
+    return true;
+
+  if (takeTask(&executor.injected, false, task))
+    return true;
+
+  for (int i = 1; i <= count; ++i) {
+    int victim = (self + i + count) % count;
+
+    if (victim != self && takeTask(executor.queues[victim], false, task))
+      return true;
+  }
+
+  return false;
+}
+
+static void finishTask(ForLoop *loop, int count) {
+  if (loop->remaining.fetch_sub(count) != count)
+    return;
+
+  if (loop->detached) {
+    delete loop;
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(loop->mutex);
+  loop->finished = true;
+  loop->done.notify_all();
+}
+
+static void runTask(const Task &task) {
+  ForLoop *loop = task.loop;
+  int begin = task.begin;
+  int end = task.end;
+  int64_t startedAt = now();
+  int64_t waited = startedAt - task.queuedAt;
+
+  executor.waitTime += waited;
+  updateMax(executor.maxWaitTime, waited);
+
+  while (end - begin > loop->grain) {
+    int middle = begin + (end - begin) / 2;
+    Task half = {loop, middle, end, 0};
+
+    pushTask(executor.queues[workerIndex], half);
+    end = middle;
+  }
+
+  for (int i = begin; i < end; ++i)
+    loop->callback(loop->data, i);
+
+  executor.runTime += now() - startedAt;
+  executor.completed++;
+
+  finishTask(loop, end - begin);
+}
+
+static void setAffinity(int cpu) {
+#if defined(_WIN32)
+  SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << (cpu % (int)(sizeof(DWORD_PTR) * 8)));
+#elif defined(__linux__)
+  cpu_set_t cpuset;
+
+  CPU_ZERO(&cpuset);
+  CPU_SET(cpu, &cpuset);
+  pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+#else
+  (void)cpu; /* Not supported on this platform */
+#endif
+}
+
+static void workerMain(int index) {
+  Task task;
+  int cores = (int)std::thread::hardware_concurrency();
+
+  workerIndex = index;
+
+  if (executor.affinity && cores > 0)
+    setAffinity(index % cores);
+
+  for (;;) {
+    if (popTask(&task)) {
+      runTask(task);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(executor.mutex);
+    executor.wakeup.wait(lock, [] { return executor.stopping || executor.pending > 0; });
+
+    if (executor.stopping && executor.pending == 0)
+      return;
+  }
+}
+
+/* Callers must hold configMutex */
+static void startWorkers(int nbThread) {
+  if (nbThread <= 0)
+    nbThread = (int)std::thread::hardware_concurrency();
+
+  nbThread = nbThread > 0 ? nbThread : 1;
+
+  for (int i = 0; i < nbThread; ++i)
+    executor.queues.push_back(new TaskQueue());
+
+  for (int i = 0; i < nbThread; ++i)
+    executor.threads.emplace_back(workerMain, i);
+
+  executor.nbThread = nbThread;
+  executor.started = true;
+}
+
+/* Callers must hold configMutex, workers drain all queued tasks before exiting */
+static void stopWorkers(void) {
+  {
+    std::lock_guard<std::mutex> lock(executor.mutex);
+    executor.stopping = true;
+  }
+
+  executor.wakeup.notify_all();
+
+  for (auto iter = executor.threads.begin(); iter != executor.threads.end(); iter++)
+    iter->join();
+
+  for (auto iter = executor.queues.begin(); iter != executor.queues.end(); iter++)
+    delete *iter;
+
+  executor.threads.clear();
+  executor.queues.clear();
+  executor.stopping = false;
+  executor.started = false;
+}
+
+static void ensureStarted(void) {
+  if (executor.started)
+    return;
+
+  std::lock_guard<std::mutex> lock(executor.configMutex);
+
+  if (!executor.started)
+    startWorkers(0);
+}
+
+Executor::~Executor() {
+  std::lock_guard<std::mutex> lock(configMutex);
+
+  if (started)
+    stopWorkers();
+}
+
+static void waitLoop(ForLoop *loop) {
+  Task task;
+
+  /* A worker waiting on a nested loop keeps executing tasks instead of blocking */
+  if (workerIndex >= 0) {
+    while (loop->remaining > 0) {
+      if (popTask(&task))
+        runTask(task);
+      else
+        std::this_thread::yield();
+    }
+  }
+
+  std::unique_lock<std::mutex> lock(loop->mutex);
+  loop->done.wait(lock, [loop] { return loop->finished; });
+}
+
+void executorParallelFor(int count, int grain, ExecutorCallback callback, void *data) {
+  if (count <= 0)
+    return;
+
+  ensureStarted();
+
+  ForLoop loop(callback, data, grain, count, false);
+  Task task = {&loop, 0, count, 0};
+
+  pushTask(workerIndex >= 0 ? executor.queues[workerIndex] : &executor.injected, task);
+  waitLoop(&loop);
+}
+
+void executorSubmit(ExecutorCallback callback, void *data) {
+  ensureStarted();
+
+  ForLoop *loop = new ForLoop(callback, data, 1, 1, true);
+  Task task = {loop, 0, 1, 0};
+
+  pushTask(workerIndex >= 0 ? executor.queues[workerIndex] : &executor.injected, task);
+}
+
+void executorConfigure(int threads, bool affinity) {
+  std::lock_guard<std::mutex> lock(executor.configMutex);
+
+  if (executor.started)
+    stopWorkers();
+
+  executor.affinity = affinity;
+  startWorkers(threads);
+}
+
+int executorThreads(void) {
+  ensureStarted();
+
+  return executor.nbThread;
+}
+
+void executorGetStats(ExecutorStats *stats) {
+  stats->threads = executor.nbThread;
+  stats->queued = executor.pending > 0 ? (int64_t)executor.pending : 0;
+  stats->maxQueued = executor.maxQueued;
+  stats->submitted = executor.submitted;
+  stats->completed = executor.completed;
+  stats->waitTime = executor.waitTime;
+  stats->maxWaitTime = executor.maxWaitTime;
+  stats->runTime = executor.runTime;
+}
+
+void executorResetStats(void) {
+  executor.maxQueued = 0;
+  executor.submitted = 0;
+  executor.completed = 0;
+  executor.waitTime = 0;
+  executor.maxWaitTime = 0;
+  executor.runTime = 0;
+}
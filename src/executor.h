@@ -0,0 +1,48 @@
+/*
+ * executor.h
+ *
+ * Copyright (c) 2024-2025 Xiongfei Shi
+ *
+ * Author: Xiongfei Shi <xiongfei.shi(a)icloud.com>
+ * License: Apache-2.0
+ *
+ * https://github.com/shixiongfei/napi-talib
+ */
+
+#ifndef NAPI_TALIB_EXECUTOR_H
+#define NAPI_TALIB_EXECUTOR_H
+
+#include <stdint.h>
+
+typedef void (*ExecutorCallback)(void *data, int index);
+
+typedef struct ExecutorStats {
+  int threads;
+  int64_t queued;
+  int64_t maxQueued;
+  int64_t submitted;
+  int64_t completed;
+  int64_t waitTime;
+  int64_t maxWaitTime;
+  int64_t runTime;
+} ExecutorStats;
+
+/* Run callback(data, i) for every i in [0, count) and wait until all are done.
+ * Ranges larger than grain are split and stolen by idle workers. */
+void executorParallelFor(int count, int grain, ExecutorCallback callback, void *data);
+
+/* Queue callback(data, 0) and return immediately */
+void executorSubmit(ExecutorCallback callback, void *data);
+
+/* Resize the pool (0 means one thread per core), queued tasks finish first.
+ * With affinity, worker i is pinned to core i modulo the core count. */
+void executorConfigure(int threads, bool affinity);
+
+/* Number of worker threads */
+int executorThreads(void);
+
+/* Counters since start or the last reset, times are in microseconds */
+void executorGetStats(ExecutorStats *stats);
+void executorResetStats(void);
+
+#endif
@@ -0,0 +1,104 @@
+/*
+ * kernels.cpp
+ *
+ * Copyright (c) 2024-2025 Xiongfei Shi
+ *
+ * Author: Xiongfei Shi <xiongfei.shi(a)icloud.com>
+ * License: Apache-2.0
+ *
+ * https://github.com/shixiongfei/napi-talib
+ */
+
+#include "kernels.h"
+#include <string.h>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+static const char *kernelNames[KERNEL_COUNT] = {
+    "ADD", "SUB", "MULT", "DIV", "SQRT", "CEIL", "FLOOR",
+    "AVGPRICE", "MEDPRICE", "TYPPRICE", "WCLPRICE",
+};
+
+typedef struct KernelSet {
+  const char *isa;
+  const KernelFunc *table;
+} KernelSet;
+
+#if defined(__x86_64__) || defined(_M_X64)
+#if defined(_MSC_VER)
+/* The OS has to save the wider registers too, as reported by XCR0 */
+static bool cpuSupports(int leaf, int subleaf, int reg, int bit, unsigned long long xcr0) {
+  int info[4];
+
+  __cpuid(info, 0);
+
+  if (info[0] < leaf)
+    return false;
+
+  __cpuidex(info, 1, 0);
+
+  /* OSXSAVE */
+  if (!(info[2] & (1 << 27)) || (_xgetbv(0) & xcr0) != xcr0)
+    return false;
+
+  __cpuidex(info, leaf, subleaf);
+  return (info[reg] & (1 << bit)) != 0;
+}
+
+static bool hasAvx2(void) {
+  return cpuSupports(7, 0, 1, 5, 0x06);
+}
+
+static bool hasAvx512(void) {
+  return cpuSupports(7, 0, 1, 16, 0xe6);
+}
+#else
+static bool hasAvx2(void) {
+  return __builtin_cpu_supports("avx2");
+}
+
+static bool hasAvx512(void) {
+  return __builtin_cpu_supports("avx512f");
+}
+#endif
+
+static KernelSet detectKernelSet(void) {
+  if (hasAvx512())
+    return {"avx512", kernelsAvx512};
+
+  if (hasAvx2())
+    return {"avx2", kernelsAvx2};
+
+  /* Part of x86-64 itself */
+  return {"sse2", kernelsSse2};
+}
+#else
+static KernelSet detectKernelSet(void) {
+  return {"none", nullptr};
+}
+#endif
+
+static const KernelSet &getKernelSet(void) {
+  static const KernelSet kernelSet = detectKernelSet();
+  return kernelSet;
+}
+
+KernelFunc kernelFind(const char *funcName) {
+  const KernelSet &kernelSet = getKernelSet();
+
+  if (!kernelSet.table)
+    return nullptr;
+
+  for (int i = 0; i < KERNEL_COUNT; ++i)
+    if (strcmp(kernelNames[i], funcName) == 0)
+      return kernelSet.table[i];
+
+  return nullptr;
+}
+
+const char *kernelIsa(void) {
+  return getKernelSet().isa;
+}
@@ -0,0 +1,47 @@
+/*
+ * kernels.h
+ *
+ * Copyright (c) 2024-2025 Xiongfei Shi
+ *
+ * Author: Xiongfei Shi <xiongfei.shi(a)icloud.com>
+ * License: Apache-2.0
+ *
+ * https://github.com/shixiongfei/napi-talib
+ */
+
+#ifndef NAPI_TALIB_KERNELS_H
+#define NAPI_TALIB_KERNELS_H
+
+/* Inputs follow the TA-Lib inputs with prices expanded in open, high, low,
+ * close, volume, openInterest order. output[i] is computed from element i
+ * of every input. */
+typedef void (*KernelFunc)(const double *const *inputs, double *output, int count);
+
+enum KernelId {
+  KERNEL_ADD,
+  KERNEL_SUB,
+  KERNEL_MULT,
+  KERNEL_DIV,
+  KERNEL_SQRT,
+  KERNEL_CEIL,
+  KERNEL_FLOOR,
+  KERNEL_AVGPRICE,
+  KERNEL_MEDPRICE,
+  KERNEL_TYPPRICE,
+  KERNEL_WCLPRICE,
+  KERNEL_COUNT,
+};
+
+/* One table per instruction set, built in kernels_<isa>.cpp */
+extern const KernelFunc kernelsSse2[KERNEL_COUNT];
+extern const KernelFunc kernelsAvx2[KERNEL_COUNT];
+extern const KernelFunc kernelsAvx512[KERNEL_COUNT];
+
+/* Vectorized kernel for an elementwise function on this CPU, nullptr if
+ * none. The results are bit-identical to TA-Lib. */
+KernelFunc kernelFind(const char *funcName);
+
+/* Instruction set picked at startup: "avx512", "avx2", "sse2" or "none" */
+const char *kernelIsa(void);
+
+#endif
@@ -0,0 +1,31 @@
+/*
+ * kernels_avx2.cpp
+ *
+ * Copyright (c) 2024-2025 Xiongfei Shi
+ *
+ * Author: Xiongfei Shi <xiongfei.shi(a)icloud.com>
+ * License: Apache-2.0
+ *
+ * https://github.com/shixiongfei/napi-talib
+ */
+
+/* Built with -mavx2 (/arch:AVX2), only called once the CPU reports AVX2 */
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+
+#define KERNEL_TABLE kernelsAvx2
+#define VEC __m256d
+#define VEC_WIDTH 4
+#define VEC_LOAD _mm256_loadu_pd
+#define VEC_STORE _mm256_storeu_pd
+#define VEC_SET1 _mm256_set1_pd
+#define VEC_ADD _mm256_add_pd
+#define VEC_SUB _mm256_sub_pd
+#define VEC_MUL _mm256_mul_pd
+#define VEC_DIV _mm256_div_pd
+#define VEC_SQRT _mm256_sqrt_pd
+#define VEC_CEIL _mm256_ceil_pd
+#define VEC_FLOOR _mm256_floor_pd
+
+#include "kernels_impl.h"
+#endif
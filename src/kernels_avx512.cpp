@@ -0,0 +1,31 @@
+/*
+ * kernels_avx512.cpp
+ *
+ * Copyright (c) 2024-2025 Xiongfei Shi
+ *
+ * Author: Xiongfei Shi <xiongfei.shi(a)icloud.com>
+ * License: Apache-2.0
+ *
+ * https://github.com/shixiongfei/napi-talib
+ */
+
+/* Built with -mavx512f (/arch:AVX512), only called once the CPU reports AVX-512F */
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+
+#define KERNEL_TABLE kernelsAvx512
+#define VEC __m512d
+#define VEC_WIDTH 8
+#define VEC_LOAD _mm512_loadu_pd
+#define VEC_STORE _mm512_storeu_pd
+#define VEC_SET1 _mm512_set1_pd
+#define VEC_ADD _mm512_add_pd
+#define VEC_SUB _mm512_sub_pd
+#define VEC_MUL _mm512_mul_pd
+#define VEC_DIV _mm512_div_pd
+#define VEC_SQRT _mm512_sqrt_pd
+#define VEC_CEIL(x) _mm512_roundscale_pd(x, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC)
+#define VEC_FLOOR(x) _mm512_roundscale_pd(x, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC)
+
+#include "kernels_impl.h"
+#endif
@@ -0,0 +1,127 @@
+/*
+ * kernels_impl.h
+ *
+ * Copyright (c) 2024-2025 Xiongfei Shi
+ *
+ * Author: Xiongfei Shi <xiongfei.shi(a)icloud.com>
+ * License: Apache-2.0
+ *
+ * https://github.com/shixiongfei/napi-talib
+ */
+
+/* Included once by each kernels_<isa>.cpp, which defines KERNEL_TABLE and
+ * the VEC_* operations. The expressions keep TA-Lib's evaluation order so
+ * that every lane rounds exactly like the scalar code. */
+
+#include "kernels.h"
+#include <math.h>
+
+#define BINARY_KERNEL(name, vecOp, op)                         \
+  static void name(const double *const *in, double *out, int count) { \
+    const double *a = in[0], *b = in[1];                       \
+    int i = 0;                                                 \
+                                                               \
+    for (; i + VEC_WIDTH <= count; i += VEC_WIDTH)             \
+      VEC_STORE(out + i, vecOp(VEC_LOAD(a + i), VEC_LOAD(b + i))); \
+                                                               \
+    for (; i < count; ++i)                                     \
+      out[i] = a[i] op b[i];                                   \
+  }
+
+#define UNARY_KERNEL(name, vecOp, op)                          \
+  static void name(const double *const *in, double *out, int count) { \
+    const double *a = in[0];                                   \
+    int i = 0;                                                 \
+                                                               \
+    for (; i + VEC_WIDTH <= count; i += VEC_WIDTH)             \
+      VEC_STORE(out + i, vecOp(VEC_LOAD(a + i)));              \
+                                                               \
+    for (; i < count; ++i)                                     \
+      out[i] = op(a[i]);                                       \
+  }
+
+BINARY_KERNEL(kernelAdd, VEC_ADD, +)
+BINARY_KERNEL(kernelSub, VEC_SUB, -)
+BINARY_KERNEL(kernelMult, VEC_MUL, *)
+BINARY_KERNEL(kernelDiv, VEC_DIV, /)
+UNARY_KERNEL(kernelSqrt, VEC_SQRT, sqrt)
+
+#if defined(VEC_CEIL)
+UNARY_KERNEL(kernelCeil, VEC_CEIL, ceil)
+UNARY_KERNEL(kernelFloor, VEC_FLOOR, floor)
+#else
+#define kernelCeil nullptr
+#define kernelFloor nullptr
+#endif
+
+/* (high + low + close + open) / 4 */
+static void kernelAvgPrice(const double *const *in, double *out, int count) {
+  const double *open = in[0], *high = in[1], *low = in[2], *close = in[3];
+  const VEC four = VEC_SET1(4.0);
+  int i = 0;
+
+  for (; i + VEC_WIDTH <= count; i += VEC_WIDTH) {
+    VEC sum = VEC_ADD(VEC_ADD(VEC_ADD(VEC_LOAD(high + i), VEC_LOAD(low + i)), VEC_LOAD(close + i)), VEC_LOAD(open + i));
+    VEC_STORE(out + i, VEC_DIV(sum, four));
+  }
+
+  for (; i < count; ++i)
+    out[i] = (high[i] + low[i] + close[i] + open[i]) / 4;
+}
+
+/* (high + low) / 2 */
+static void kernelMedPrice(const double *const *in, double *out, int count) {
+  const double *high = in[0], *low = in[1];
+  const VEC two = VEC_SET1(2.0);
+  int i = 0;
+
+  for (; i + VEC_WIDTH <= count; i += VEC_WIDTH)
+    VEC_STORE(out + i, VEC_DIV(VEC_ADD(VEC_LOAD(high + i), VEC_LOAD(low + i)), two));
+
+  for (; i < count; ++i)
+    out[i] = (high[i] + low[i]) / 2.0;
+}
+
+/* (high + low + close) / 3 */
+static void kernelTypPrice(const double *const *in, double *out, int count) {
+  const double *high = in[0], *low = in[1], *close = in[2];
+  const VEC three = VEC_SET1(3.0);
+  int i = 0;
+
+  for (; i + VEC_WIDTH <= count; i += VEC_WIDTH) {
+    VEC sum = VEC_ADD(VEC_ADD(VEC_LOAD(high + i), VEC_LOAD(low + i)), VEC_LOAD(close + i));
+    VEC_STORE(out + i, VEC_DIV(sum, three));
+  }
+
+  for (; i < count; ++i)
+    out[i] = (high[i] + low[i] + close[i]) / 3.0;
+}
+
+/* (high + low + close * 2) / 4 */
+static void kernelWclPrice(const double *const *in, double *out, int count) {
+  const double *high = in[0], *low = in[1], *close = in[2];
+  const VEC two = VEC_SET1(2.0), four = VEC_SET1(4.0);
+  int i = 0;
+
+  for (; i + VEC_WIDTH <= count; i += VEC_WIDTH) {
+    VEC sum = VEC_ADD(VEC_ADD(VEC_LOAD(high + i), VEC_LOAD(low + i)), VEC_MUL(VEC_LOAD(close + i), two));
+    VEC_STORE(out + i, VEC_DIV(sum, four));
+  }
+
+  for (; i < count; ++i)
+    out[i] = (high[i] + low[i] + (close[i] * 2.0)) / 4.0;
+}
+
+const KernelFunc KERNEL_TABLE[KERNEL_COUNT] = {
+    kernelAdd,
+    kernelSub,
+    kernelMult,
+    kernelDiv,
+    kernelSqrt,
+    kernelCeil,
+    kernelFloor,
+    kernelAvgPrice,
+    kernelMedPrice,
+    kernelTypPrice,
+    kernelWclPrice,
+};
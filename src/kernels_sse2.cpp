@@ -0,0 +1,29 @@
+/*
+ * kernels_sse2.cpp
+ *
+ * Copyright (c) 2024-2025 Xiongfei Shi
+ *
+ * Author: Xiongfei Shi <xiongfei.shi(a)icloud.com>
+ * License: Apache-2.0
+ *
+ * https://github.com/shixiongfei/napi-talib
+ */
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <emmintrin.h>
+
+#define KERNEL_TABLE kernelsSse2
+#define VEC __m128d
+#define VEC_WIDTH 2
+#define VEC_LOAD _mm_loadu_pd
+#define VEC_STORE _mm_storeu_pd
+#define VEC_SET1 _mm_set1_pd
+#define VEC_ADD _mm_add_pd
+#define VEC_SUB _mm_sub_pd
+#define VEC_MUL _mm_mul_pd
+#define VEC_DIV _mm_div_pd
+#define VEC_SQRT _mm_sqrt_pd
+
+/* Rounding needs SSE4.1, ceil and floor stay with TA-Lib */
+#include "kernels_impl.h"
+#endif
@@ -0,0 +1,247 @@
+/*
+ * pool.cpp
+ *
+ * Copyright (c) 2024-2025 Xiongfei Shi
+ *
+ * Author: Xiongfei Shi <xiongfei.shi(a)icloud.com>
+ * License: Apache-2.0
+ *
+ * https://github.com/shixiongfei/napi-talib
+ */
+
+#include "pool.h"
+#include <atomic>
+#include <mutex>
+#include <stdlib.h>
+
+#define POOL_MIN_SHIFT 6
+#define POOL_MAX_SHIFT 26
+#define POOL_CLASSES (POOL_MAX_SHIFT - POOL_MIN_SHIFT + 1)
+#define POOL_THREAD_LIMIT ((size_t)16 << 20)
+#define POOL_DEPOT_LIMIT ((size_t)256 << 20)
+
+/* Sits in front of every buffer, keeps the payload 16 bytes aligned */
+typedef struct alignas(16) Block {
+  size_t size;
+  Block *next;
+} Block;
+
+typedef struct Depot {
+  std::mutex mutex;
+  Block *lists[POOL_CLASSES];
+  size_t bytes;
+
+  std::atomic<uint64_t> generation;
+  std::atomic<int64_t> allocations;
+  std::atomic<int64_t> hits;
+  std::atomic<int64_t> misses;
+  std::atomic<int64_t> liveBytes;
+  std::atomic<int64_t> cachedBytes;
+  std::atomic<int64_t> trimmedBytes;
+
+  Depot() : generation(0), allocations(0), hits(0), misses(0), liveBytes(0), cachedBytes(0), trimmedBytes(0) {
+    for (int i = 0; i < POOL_CLASSES; ++i)
+      lists[i] = nullptr;
+
+    bytes = 0;
+  }
+} Depot;
+
+static Depot depot;
+
+static size_t releaseList(Block **list) {
+  size_t bytes = 0;
+
+  while (*list) {
+    Block *block = *list;
+
+    *list = block->next;
+    bytes += block->size;
+    free(block);
+  }
+
+  return bytes;
+}
+
+typedef struct ThreadCache {
+  Block *lists[POOL_CLASSES];
+  size_t bytes;
+  uint64_t generation;
+
+  ThreadCache() {
+    for (int i = 0; i < POOL_CLASSES; ++i)
+      lists[i] = nullptr;
+
+    bytes = 0;
+    generation = depot.generation;
+  }
+
+  size_t release() {
+    size_t released = 0;
+
+    for (int i = 0; i < POOL_CLASSES; ++i)
+      released += releaseList(&lists[i]);
+
+    depot.cachedBytes -= (int64_t)released;
+    bytes = 0;
+
+    return released;
+  }
+
+  /* Exiting threads (e.g. a resized executor) give their buffers back */
+  ~ThreadCache() { release(); }
+} ThreadCache;
+
+static thread_local ThreadCache threadCache;
+
+static int sizeClass(size_t size) {
+  int shift = POOL_MIN_SHIFT;
+
+  while (shift <= POOL_MAX_SHIFT && ((size_t)1 << shift) < size)
+    shift += 1;
+
+  return shift - POOL_MIN_SHIFT;
+}
+
+static ThreadCache *getThreadCache(void) {
+  ThreadCache *cache = &threadCache;
+
+  /* A trim happened since this thread last touched the pool */
+  if (cache->generation != depot.generation) {
+    depot.trimmedBytes += (int64_t)cache->release();
+    cache->generation = depot.generation;
+  }
+
+  return cache;
+}
+
+void *poolAlloc(size_t size) {
+  int index = sizeClass(size > 0 ? size : 1);
+  ThreadCache *cache;
+  Block *block = nullptr;
+
+  depot.allocations++;
+
+  /* Too large to be worth keeping around */
+  if (index >= POOL_CLASSES) {
+    if (!(block = (Block *)malloc(sizeof(Block) + size)))
+      return nullptr;
+
+    block->size = size;
+    depot.misses++;
+    depot.liveBytes += (int64_t)size;
+
+    return block + 1;
+  }
+
+  cache = getThreadCache();
+
+  if ((block = cache->lists[index])) {
+    cache->lists[index] = block->next;
+    cache->bytes -= block->size;
+  } else {
+    std::lock_guard<std::mutex> lock(depot.mutex);
+
+    if ((block = depot.lists[index])) {
+      depot.lists[index] = block->next;
+      depot.bytes -= block->size;
+    }
+  }
+
+  if (block) {
+    depot.hits++;
+    depot.cachedBytes -= (int64_t)block->size;
+  } else {
+    size_t capacity = (size_t)1 << (index + POOL_MIN_SHIFT);
+
+    if (!(block = (Block *)malloc(sizeof(Block) + capacity)))
+      return nullptr;
+
+    block->size = capacity;
+    depot.misses++;
+  }
+
+  depot.liveBytes += (int64_t)block->size;
+  return block + 1;
+}
+
+void poolFree(void *ptr) {
+  Block *block;
+  ThreadCache *cache;
+  int index;
+
+  if (!ptr)
+    return;
+
+  block = (Block *)ptr - 1;
+  index = sizeClass(block->size);
+  depot.liveBytes -= (int64_t)block->size;
+
+  if (index >= POOL_CLASSES) {
+    free(block);
+    return;
+  }
+
+  cache = getThreadCache();
+
+  if (cache->bytes + block->size <= POOL_THREAD_LIMIT) {
+    block->next = cache->lists[index];
+    cache->lists[index] = block;
+    cache->bytes += block->size;
+    depot.cachedBytes += (int64_t)block->size;
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(depot.mutex);
+
+    if (depot.bytes + block->size <= POOL_DEPOT_LIMIT) {
+      block->next = depot.lists[index];
+      depot.lists[index] = block;
+      depot.bytes += block->size;
+      depot.cachedBytes += (int64_t)block->size;
+      return;
+    }
+  }
+
+  free(block);
+}
+
+size_t poolTrim(void) {
+  size_t released, shared = 0;
+
+  depot.generation++;
+  released = threadCache.release();
+  threadCache.generation = depot.generation;
+
+  {
+    std::lock_guard<std::mutex> lock(depot.mutex);
+
+    for (int i = 0; i < POOL_CLASSES; ++i)
+      shared += releaseList(&depot.lists[i]);
+
+    depot.cachedBytes -= (int64_t)shared;
+    depot.bytes = 0;
+  }
+
+  released += shared;
+
+  depot.trimmedBytes += (int64_t)released;
+  return released;
+}
+
+void poolGetStats(PoolStats *stats) {
+  stats->allocations = depot.allocations;
+  stats->hits = depot.hits;
+  stats->misses = depot.misses;
+  stats->liveBytes = depot.liveBytes;
+  stats->cachedBytes = depot.cachedBytes;
+  stats->trimmedBytes = depot.trimmedBytes;
+}
+
+void poolResetStats(void) {
+  depot.allocations = 0;
+  depot.hits = 0;
+  depot.misses = 0;
+  depot.trimmedBytes = 0;
+}
@@ -0,0 +1,40 @@
+/*
+ * pool.h
+ *
+ * Copyright (c) 2024-2025 Xiongfei Shi
+ *
+ * Author: Xiongfei Shi <xiongfei.shi(a)icloud.com>
+ * License: Apache-2.0
+ *
+ * https://github.com/shixiongfei/napi-talib
+ */
+
+#ifndef NAPI_TALIB_POOL_H
+#define NAPI_TALIB_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct PoolStats {
+  int64_t allocations;
+  int64_t hits;
+  int64_t misses;
+  int64_t liveBytes;
+  int64_t cachedBytes;
+  int64_t trimmedBytes;
+} PoolStats;
+
+/* Buffers are rounded up to a power of two size class and recycled through a
+ * per-thread cache, then a shared depot. Memory is not zero filled. */
+void *poolAlloc(size_t size);
+void poolFree(void *ptr);
+
+/* Release the depot and the caller's cache, other threads drop theirs on
+ * their next allocation. Returns the number of bytes released now. */
+size_t poolTrim(void);
+
+/* Counters since start or the last reset, byte gauges are never reset */
+void poolGetStats(PoolStats *stats);
+void poolResetStats(void);
+
+#endif
@@ -0,0 +1,136 @@
+/*
+ * resample.cpp
+ *
+ * Copyright (c) 2024-2025 Xiongfei Shi
+ *
+ * Author: Xiongfei Shi <xiongfei.shi(a)icloud.com>
+ * License: Apache-2.0
+ *
+ * https://github.com/shixiongfei/napi-talib
+ */
+
+#include "resample.h"
+#include <math.h>
+#include <stdint.h>
+#include <vector>
+
+struct Resampler {
+  std::vector<ResampleRule> rules;
+  std::vector<double> row;
+  int every;
+  double interval;
+  double origin;
+  int64_t bucket;
+  int filled;
+  bool started;
+};
+
+Resampler *resamplerCreate(const ResampleRule *rules, int nbColumn, int every, double interval, double origin) {
+  Resampler *resampler = new Resampler();
+
+  resampler->rules.assign(rules, rules + nbColumn);
+  resampler->row.assign(nbColumn, NAN);
+  resampler->every = every > 0 ? every : 1;
+  resampler->interval = interval;
+  resampler->origin = origin;
+  resampler->bucket = 0;
+  resampler->filled = 0;
+  resampler->started = false;
+
+  return resampler;
+}
+
+void resamplerFree(Resampler *resampler) {
+  delete resampler;
+}
+
+static double bucketAt(const Resampler *resampler, double time) {
+  return floor((time - resampler->origin) / resampler->interval);
+}
+
+static int64_t bucketOf(const Resampler *resampler, double time) {
+  return (int64_t)bucketAt(resampler, time);
+}
+
+bool resamplerCheck(const Resampler *resampler, const double *times, size_t count) {
+  int64_t bucket = resampler->bucket;
+  bool started = resampler->started;
+
+  if (resampler->interval <= 0)
+    return true;
+
+  for (size_t i = 0; i < count; ++i) {
+    double index = bucketAt(resampler, times[i]);
+
+    /* NaN fails both comparisons */
+    if (!(index >= (double)INT64_MIN && index < -(double)INT64_MIN))
+      return false;
+
+    if (started && (int64_t)index < bucket)
+      return false;
+
+    bucket = (int64_t)index;
+    started = true;
+  }
+
+  return true;
+}
+
+/* NaN values are skipped, e.g. a missing volume does not void the row */
+static double fold(ResampleRule rule, double value, double bar) {
+  if (isnan(value))
+    return rule == RESAMPLE_BUCKET ? value : bar;
+
+  if (isnan(bar))
+    return value;
+
+  switch (rule) {
+  case RESAMPLE_LAST:
+    return bar;
+
+  case RESAMPLE_MAX:
+    return bar > value ? bar : value;
+
+  case RESAMPLE_MIN:
+    return bar < value ? bar : value;
+
+  case RESAMPLE_SUM:
+    return value + bar;
+
+  default:
+    return value;
+  }
+}
+
+bool resamplerPush(Resampler *resampler, const double *bar, double time) {
+  bool opened;
+
+  if (resampler->interval > 0) {
+    int64_t bucket = bucketOf(resampler, time);
+
+    opened = !resampler->started || bucket != resampler->bucket;
+    resampler->bucket = bucket;
+  } else {
+    opened = !resampler->started || resampler->filled >= resampler->every;
+  }
+
+  resampler->started = true;
+  resampler->filled = opened ? 1 : resampler->filled + 1;
+
+  for (size_t i = 0; i < resampler->rules.size(); ++i) {
+    if (resampler->rules[i] == RESAMPLE_BUCKET)
+      resampler->row[i] = resampler->origin + (double)resampler->bucket * resampler->interval;
+    else
+      resampler->row[i] = opened ? bar[i] : fold(resampler->rules[i], resampler->row[i], bar[i]);
+  }
+
+  return opened;
+}
+
+const double *resamplerRow(const Resampler *resampler) {
+  return resampler->row.data();
+}
+
+bool resamplerRowComplete(const Resampler *resampler) {
+  return resampler->interval <= 0 && resampler->filled >= resampler->every;
+}
@@ -0,0 +1,46 @@
+/*
+ * resample.h
+ *
+ * Copyright (c) 2024-2025 Xiongfei Shi
+ *
+ * Author: Xiongfei Shi <xiongfei.shi(a)icloud.com>
+ * License: Apache-2.0
+ *
+ * https://github.com/shixiongfei/napi-talib
+ */
+
+#ifndef NAPI_TALIB_RESAMPLE_H
+#define NAPI_TALIB_RESAMPLE_H
+
+#include <stddef.h>
+
+/* How the base bars of a row combine, BUCKET is the start of the time bucket */
+typedef enum ResampleRule {
+  RESAMPLE_FIRST,
+  RESAMPLE_LAST,
+  RESAMPLE_MAX,
+  RESAMPLE_MIN,
+  RESAMPLE_SUM,
+  RESAMPLE_BUCKET,
+} ResampleRule;
+
+typedef struct Resampler Resampler;
+
+/* A row per 'every' base bars, or with 'interval' > 0 per non-empty bucket
+ * floor((time - origin) / interval). */
+Resampler *resamplerCreate(const ResampleRule *rules, int nbColumn, int every, double interval, double origin);
+void resamplerFree(Resampler *resampler);
+
+/* False if a time is not a number, its bucket does not fit an int64 or it
+ * falls in a bucket before the current one, nothing is folded then */
+bool resamplerCheck(const Resampler *resampler, const double *times, size_t count);
+
+/* Fold one base bar with a value per column, true when it opened a new row.
+ * The row stays open until the next one starts. */
+bool resamplerPush(Resampler *resampler, const double *bar, double time);
+const double *resamplerRow(const Resampler *resampler);
+
+/* Whether the open row has all its base bars, only known by bar count */
+bool resamplerRowComplete(const Resampler *resampler);
+
+#endif
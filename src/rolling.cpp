@@ -0,0 +1,439 @@
+/*
+ * rolling.cpp
+ *
+ * Copyright (c) 2024-2025 Xiongfei Shi
+ *
+ * Author: Xiongfei Shi <xiongfei.shi(a)icloud.com>
+ * License: Apache-2.0
+ *
+ * https://github.com/shixiongfei/napi-talib
+ */
+
+#include "rolling.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#define OPT_INT(i) ((int)opt[i])
+#define OPT_MA(i) ((TA_MAType)(int)opt[i])
+
+/* TA-Lib does not range check optInputs set through the abstract interface,
+ * so the deques only run within the ranges of the functions themselves.
+ * Anything else is left to TA-Lib, which reports TA_BAD_PARAM. */
+static bool periodInRange(const double *opt, int index, int minimum) {
+  return opt[index] >= minimum && opt[index] <= 100000;
+}
+
+static bool maTypeInRange(const double *opt, int index) {
+  return opt[index] >= TA_MAType_SMA && opt[index] <= TA_MAType_T3;
+}
+
+/* Extreme of a sliding window. 'index' follows TA-Lib's own state: a new bar
+ * that ties or beats it takes over, and once it leaves the window it is
+ * rescanned, which here is the front of the deque. 'latest' keeps the last
+ * of equal values at the front, as the rescan loop of some functions does. */
+typedef struct Extreme {
+  const double *values;
+  std::vector<int> deque;
+  int head;
+  int size;
+  int index;
+  bool highest;
+  bool latest;
+} Extreme;
+
+static void extremeInit(Extreme *extreme, const double *values, int window, bool highest, bool latest) {
+  extreme->values = values;
+  extreme->deque.resize(window);
+  extreme->head = 0;
+  extreme->size = 0;
+  extreme->index = -1;
+  extreme->highest = highest;
+  extreme->latest = latest;
+}
+
+static bool extremeBeats(const Extreme *extreme, double value, double other, bool ties) {
+  if (extreme->highest)
+    return ties ? value >= other : value > other;
+
+  return ties ? value <= other : value < other;
+}
+
+/* Moves the window to [trailingIdx, today] */
+static void extremeSlide(Extreme *extreme, int trailingIdx, int today) {
+  int capacity = (int)extreme->deque.size();
+  double value = extreme->values[today];
+
+  while (extreme->size > 0 && extreme->deque[extreme->head] < trailingIdx) {
+    extreme->head = (extreme->head + 1) % capacity;
+    extreme->size -= 1;
+  }
+
+  while (extreme->size > 0 && extremeBeats(extreme, value, extreme->values[extreme->deque[(extreme->head + extreme->size - 1) % capacity]], extreme->latest))
+    extreme->size -= 1;
+
+  extreme->deque[(extreme->head + extreme->size) % capacity] = today;
+  extreme->size += 1;
+}
+
+static int extremeFront(const Extreme *extreme) {
+  return extreme->deque[extreme->head];
+}
+
+static int extremeUpdate(Extreme *extreme, int trailingIdx, int today) {
+  extremeSlide(extreme, trailingIdx, today);
+
+  if (extreme->index < trailingIdx)
+    extreme->index = extremeFront(extreme);
+  else if (extremeBeats(extreme, extreme->values[today], extreme->values[extreme->index], true))
+    extreme->index = today;
+
+  return extreme->index;
+}
+
+/* Bars before the first output only enter the window */
+static void extremeFill(Extreme *extreme, int trailingIdx, int today) {
+  for (int i = trailingIdx; i < today; ++i)
+    extremeSlide(extreme, trailingIdx, i);
+}
+
+static bool hasNaN(const double *values, int begIdx, int endIdx) {
+  for (int i = begIdx; i <= endIdx; ++i)
+    if (isnan(values[i]))
+      return true;
+
+  return false;
+}
+
+/* Same checks and clamping as the TA-Lib functions, false when there is nothing left to do */
+static bool beginRolling(int *startIdx, int endIdx, int lookback, int *outBegIdx, int *outNBElement, TA_RetCode *retCode) {
+  *outBegIdx = 0;
+  *outNBElement = 0;
+
+  if (*startIdx < 0) {
+    *retCode = TA_OUT_OF_RANGE_START_INDEX;
+    return false;
+  }
+
+  if (endIdx < 0 || endIdx < *startIdx) {
+    *retCode = TA_OUT_OF_RANGE_END_INDEX;
+    return false;
+  }
+
+  *retCode = TA_SUCCESS;
+  *startIdx = *startIdx < lookback ? lookback : *startIdx;
+
+  return *startIdx <= endIdx;
+}
+
+/* MAX, MIN, MAXINDEX, MININDEX, MINMAX and MINMAXINDEX */
+static TA_RetCode rollingMinMax(int startIdx, int endIdx, const double *inReal, int period, bool lowest, bool highest, bool indexes, int *outBegIdx, int *outNBElement, void *const *out) {
+  Extreme low, high;
+  int lookback = period - 1, outIdx = 0, slot;
+  TA_RetCode retCode;
+
+  if (!beginRolling(&startIdx, endIdx, lookback, outBegIdx, outNBElement, &retCode))
+    return retCode;
+
+  if (hasNaN(inReal, startIdx - lookback, endIdx))
+    return TA_NOT_SUPPORTED;
+
+  extremeInit(&low, inReal, period, false, false);
+  extremeInit(&high, inReal, period, true, false);
+
+  extremeFill(&low, startIdx - lookback, startIdx);
+  extremeFill(&high, startIdx - lookback, startIdx);
+
+  for (int today = startIdx; today <= endIdx; ++today, ++outIdx) {
+    slot = 0;
+
+    if (lowest) {
+      int index = extremeUpdate(&low, today - lookback, today);
+
+      if (indexes)
+        ((int *)out[slot++])[outIdx] = index;
+      else
+        ((double *)out[slot++])[outIdx] = inReal[index];
+    }
+
+    if (highest) {
+      int index = extremeUpdate(&high, today - lookback, today);
+
+      if (indexes)
+        ((int *)out[slot++])[outIdx] = index;
+      else
+        ((double *)out[slot++])[outIdx] = inReal[index];
+    }
+  }
+
+  *outBegIdx = startIdx;
+  *outNBElement = outIdx;
+
+  return TA_SUCCESS;
+}
+
+static TA_RetCode rollingMAX(int startIdx, int endIdx, const double *const *in, const double *opt, int *outBegIdx, int *outNBElement, void *const *out) {
+  if (!periodInRange(opt, 0, 2))
+    return TA_NOT_SUPPORTED;
+
+  return rollingMinMax(startIdx, endIdx, in[0], OPT_INT(0), false, true, false, outBegIdx, outNBElement, out);
+}
+
+static TA_RetCode rollingMAXINDEX(int startIdx, int endIdx, const double *const *in, const double *opt, int *outBegIdx, int *outNBElement, void *const *out) {
+  if (!periodInRange(opt, 0, 2))
+    return TA_NOT_SUPPORTED;
+
+  return rollingMinMax(startIdx, endIdx, in[0], OPT_INT(0), false, true, true, outBegIdx, outNBElement, out);
+}
+
+static TA_RetCode rollingMIN(int startIdx, int endIdx, const double *const *in, const double *opt, int *outBegIdx, int *outNBElement, void *const *out) {
+  if (!periodInRange(opt, 0, 2))
+    return TA_NOT_SUPPORTED;
+
+  return rollingMinMax(startIdx, endIdx, in[0], OPT_INT(0), true, false, false, outBegIdx, outNBElement, out);
+}
+
+static TA_RetCode rollingMININDEX(int startIdx, int endIdx, const double *const *in, const double *opt, int *outBegIdx, int *outNBElement, void *const *out) {
+  if (!periodInRange(opt, 0, 2))
+    return TA_NOT_SUPPORTED;
+
+  return rollingMinMax(startIdx, endIdx, in[0], OPT_INT(0), true, false, true, outBegIdx, outNBElement, out);
+}
+
+static TA_RetCode rollingMINMAX(int startIdx, int endIdx, const double *const *in, const double *opt, int *outBegIdx, int *outNBElement, void *const *out) {
+  if (!periodInRange(opt, 0, 2))
+    return TA_NOT_SUPPORTED;
+
+  return rollingMinMax(startIdx, endIdx, in[0], OPT_INT(0), true, true, false, outBegIdx, outNBElement, out);
+}
+
+static TA_RetCode rollingMINMAXINDEX(int startIdx, int endIdx, const double *const *in, const double *opt, int *outBegIdx, int *outNBElement, void *const *out) {
+  if (!periodInRange(opt, 0, 2))
+    return TA_NOT_SUPPORTED;
+
+  return rollingMinMax(startIdx, endIdx, in[0], OPT_INT(0), true, true, true, outBegIdx, outNBElement, out);
+}
+
+/* MIDPOINT and MIDPRICE scan the whole window every bar, the first extreme wins */
+static TA_RetCode rollingMid(int startIdx, int endIdx, const double *inHigh, const double *inLow, int period, int *outBegIdx, int *outNBElement, double *outReal) {
+  Extreme low, high;
+  int lookback = period - 1, outIdx = 0;
+  TA_RetCode retCode;
+
+  if (!beginRolling(&startIdx, endIdx, lookback, outBegIdx, outNBElement, &retCode))
+    return retCode;
+
+  if (hasNaN(inHigh, startIdx - lookback, endIdx) || hasNaN(inLow, startIdx - lookback, endIdx))
+    return TA_NOT_SUPPORTED;
+
+  extremeInit(&low, inLow, period, false, false);
+  extremeInit(&high, inHigh, period, true, false);
+
+  extremeFill(&low, startIdx - lookback, startIdx);
+  extremeFill(&high, startIdx - lookback, startIdx);
+
+  for (int today = startIdx; today <= endIdx; ++today) {
+    extremeSlide(&low, today - lookback, today);
+    extremeSlide(&high, today - lookback, today);
+
+    outReal[outIdx++] = (inHigh[extremeFront(&high)] + inLow[extremeFront(&low)]) / 2.0;
+  }
+
+  *outBegIdx = startIdx;
+  *outNBElement = outIdx;
+
+  return TA_SUCCESS;
+}
+
+static TA_RetCode rollingMIDPOINT(int startIdx, int endIdx, const double *const *in, const double *opt, int *outBegIdx, int *outNBElement, void *const *out) {
+  if (!periodInRange(opt, 0, 2))
+    return TA_NOT_SUPPORTED;
+
+  return rollingMid(startIdx, endIdx, in[0], in[0], OPT_INT(0), outBegIdx, outNBElement, (double *)out[0]);
+}
+
+static TA_RetCode rollingMIDPRICE(int startIdx, int endIdx, const double *const *in, const double *opt, int *outBegIdx, int *outNBElement, void *const *out) {
+  if (!periodInRange(opt, 0, 2))
+    return TA_NOT_SUPPORTED;
+
+  return rollingMid(startIdx, endIdx, in[0], in[1], OPT_INT(0), outBegIdx, outNBElement, (double *)out[0]);
+}
+
+static TA_RetCode rollingWILLR(int startIdx, int endIdx, const double *const *in, const double *opt, int *outBegIdx, int *outNBElement, void *const *out) {
+  const double *inHigh = in[0], *inLow = in[1], *inClose = in[2];
+  double *outReal = (double *)out[0];
+  int period, lookback, outIdx = 0;
+  double highest, lowest, diff;
+  Extreme low, high;
+  TA_RetCode retCode;
+
+  if (!periodInRange(opt, 0, 2))
+    return TA_NOT_SUPPORTED;
+
+  period = OPT_INT(0);
+  lookback = period - 1;
+
+  if (!beginRolling(&startIdx, endIdx, lookback, outBegIdx, outNBElement, &retCode))
+    return retCode;
+
+  if (hasNaN(inHigh, startIdx - lookback, endIdx) || hasNaN(inLow, startIdx - lookback, endIdx) || hasNaN(inClose, startIdx, endIdx))
+    return TA_NOT_SUPPORTED;
+
+  extremeInit(&low, inLow, period, false, false);
+  extremeInit(&high, inHigh, period, true, false);
+
+  extremeFill(&low, startIdx - lookback, startIdx);
+  extremeFill(&high, startIdx - lookback, startIdx);
+
+  for (int today = startIdx; today <= endIdx; ++today) {
+    lowest = inLow[extremeUpdate(&low, today - lookback, today)];
+    highest = inHigh[extremeUpdate(&high, today - lookback, today)];
+    diff = (highest - lowest) / (-100.0);
+
+    outReal[outIdx++] = diff != 0.0 ? (highest - inClose[today]) / diff : 0.0;
+  }
+
+  *outBegIdx = startIdx;
+  *outNBElement = outIdx;
+
+  return TA_SUCCESS;
+}
+
+/* The window spans period + 1 bars, the rescan keeps the most recent extreme */
+static TA_RetCode rollingAROON(int startIdx, int endIdx, const double *const *in, const double *opt, int *outBegIdx, int *outNBElement, void *const *out) {
+  const double *inHigh = in[0], *inLow = in[1];
+  double *outAroonDown = (double *)out[0], *outAroonUp = (double *)out[1];
+  int period, lookback, outIdx = 0;
+  double factor;
+  Extreme low, high;
+  TA_RetCode retCode;
+
+  if (!periodInRange(opt, 0, 2))
+    return TA_NOT_SUPPORTED;
+
+  period = lookback = OPT_INT(0);
+  factor = 100.0 / period;
+
+  if (!beginRolling(&startIdx, endIdx, lookback, outBegIdx, outNBElement, &retCode))
+    return retCode;
+
+  if (hasNaN(inHigh, startIdx - lookback, endIdx) || hasNaN(inLow, startIdx - lookback, endIdx))
+    return TA_NOT_SUPPORTED;
+
+  extremeInit(&low, inLow, period + 1, false, true);
+  extremeInit(&high, inHigh, period + 1, true, true);
+
+  extremeFill(&low, startIdx - lookback, startIdx);
+  extremeFill(&high, startIdx - lookback, startIdx);
+
+  for (int today = startIdx; today <= endIdx; ++today, ++outIdx) {
+    int lowestIdx = extremeUpdate(&low, today - lookback, today);
+    int highestIdx = extremeUpdate(&high, today - lookback, today);
+
+    outAroonUp[outIdx] = factor * (period - (today - highestIdx));
+    outAroonDown[outIdx] = factor * (period - (today - lowestIdx));
+  }
+
+  *outBegIdx = startIdx;
+  *outNBElement = outIdx;
+
+  return TA_SUCCESS;
+}
+
+/* Raw %K on the deques, the smoothing is TA-Lib's TA_MA as in TA_STOCH */
+static TA_RetCode rollingSTOCH(int startIdx, int endIdx, const double *const *in, const double *opt, int *outBegIdx, int *outNBElement, void *const *out) {
+  const double *inHigh = in[0], *inLow = in[1], *inClose = in[2];
+  double *outSlowK = (double *)out[0], *outSlowD = (double *)out[1];
+  int fastKPeriod, lookbackK, lookbackDSlow, lookbackTotal;
+  int trailingIdx, outIdx = 0;
+  double highest, lowest, diff;
+  std::vector<double> buffer;
+  Extreme low, high;
+  TA_RetCode retCode;
+
+  /* A fast %K of a single bar is left to TA-Lib as well */
+  if (!periodInRange(opt, 0, 2) || !periodInRange(opt, 1, 1) || !maTypeInRange(opt, 2) || !periodInRange(opt, 3, 1) || !maTypeInRange(opt, 4))
+    return TA_NOT_SUPPORTED;
+
+  fastKPeriod = OPT_INT(0);
+  lookbackK = fastKPeriod - 1;
+  lookbackDSlow = TA_MA_Lookback(OPT_INT(3), OPT_MA(4));
+  lookbackTotal = lookbackK + TA_MA_Lookback(OPT_INT(1), OPT_MA(2)) + lookbackDSlow;
+
+  if (!beginRolling(&startIdx, endIdx, lookbackTotal, outBegIdx, outNBElement, &retCode))
+    return retCode;
+
+  trailingIdx = startIdx - lookbackTotal;
+
+  if (hasNaN(inHigh, trailingIdx, endIdx) || hasNaN(inLow, trailingIdx, endIdx) || hasNaN(inClose, trailingIdx + lookbackK, endIdx))
+    return TA_NOT_SUPPORTED;
+
+  extremeInit(&low, inLow, fastKPeriod, false, false);
+  extremeInit(&high, inHigh, fastKPeriod, true, false);
+
+  extremeFill(&low, trailingIdx, trailingIdx + lookbackK);
+  extremeFill(&high, trailingIdx, trailingIdx + lookbackK);
+
+  buffer.resize(endIdx - (trailingIdx + lookbackK) + 1);
+
+  for (int today = trailingIdx + lookbackK; today <= endIdx; ++today) {
+    lowest = inLow[extremeUpdate(&low, today - lookbackK, today)];
+    highest = inHigh[extremeUpdate(&high, today - lookbackK, today)];
+    diff = (highest - lowest) / 100.0;
+
+    buffer[outIdx++] = diff != 0.0 ? (inClose[today] - lowest) / diff : 0.0;
+  }
+
+  retCode = TA_MA(0, outIdx - 1, buffer.data(), OPT_INT(1), OPT_MA(2), outBegIdx, outNBElement, buffer.data());
+
+  if (retCode != TA_SUCCESS || *outNBElement == 0) {
+    *outBegIdx = 0;
+    *outNBElement = 0;
+    return retCode;
+  }
+
+  retCode = TA_MA(0, *outNBElement - 1, buffer.data(), OPT_INT(3), OPT_MA(4), outBegIdx, outNBElement, outSlowD);
+
+  memmove(outSlowK, buffer.data() + lookbackDSlow, sizeof(double) * *outNBElement);
+
+  if (retCode != TA_SUCCESS) {
+    *outBegIdx = 0;
+    *outNBElement = 0;
+    return retCode;
+  }
+
+  *outBegIdx = startIdx;
+
+  return TA_SUCCESS;
+}
+
+typedef struct RollingEntry {
+  const char *name;
+  RollingFunc func;
+} RollingEntry;
+
+/* Sorted by name */
+static const RollingEntry rollingFuncs[] = {
+    {"AROON", rollingAROON},
+    {"MAX", rollingMAX},
+    {"MAXINDEX", rollingMAXINDEX},
+    {"MIDPOINT", rollingMIDPOINT},
+    {"MIDPRICE", rollingMIDPRICE},
+    {"MIN", rollingMIN},
+    {"MININDEX", rollingMININDEX},
+    {"MINMAX", rollingMINMAX},
+    {"MINMAXINDEX", rollingMINMAXINDEX},
+    {"STOCH", rollingSTOCH},
+    {"WILLR", rollingWILLR},
+};
+
+static int compareEntry(const void *key, const void *entry) {
+  return strcmp((const char *)key, ((const RollingEntry *)entry)->name);
+}
+
+RollingFunc rollingFind(const char *funcName) {
+  const RollingEntry *entry = (const RollingEntry *)bsearch(funcName, rollingFuncs, sizeof(rollingFuncs) / sizeof(rollingFuncs[0]), sizeof(RollingEntry), compareEntry);
+
+  return entry ? entry->func : nullptr;
+}
@@ -0,0 +1,27 @@
+/*
+ * rolling.h
+ *
+ * Copyright (c) 2024-2025 Xiongfei Shi
+ *
+ * Author: Xiongfei Shi <xiongfei.shi(a)icloud.com>
+ * License: Apache-2.0
+ *
+ * https://github.com/shixiongfei/napi-talib
+ */
+
+#ifndef NAPI_TALIB_ROLLING_H
+#define NAPI_TALIB_ROLLING_H
+
+#include "ta_func.h"
+
+/* Inputs follow the TA-Lib inputs with prices expanded in open, high, low,
+ * close order, optInputs are in TA-Lib order. Each output is a double or an
+ * int array as declared by the function. Returns TA_NOT_SUPPORTED when an
+ * input holds a NaN, TA-Lib's own scan is then the reference. */
+typedef TA_RetCode (*RollingFunc)(int startIdx, int endIdx, const double *const *inputs, const double *optInputs, int *outBegIdx, int *outNBElement, void *const *outputs);
+
+/* Rolling extremes on monotonic deques, amortized O(n) whatever the period.
+ * nullptr if funcName has none. */
+RollingFunc rollingFind(const char *funcName);
+
+#endif
@@ -0,0 +1,133 @@
+/*
+ * settings.cpp
+ *
+ * Copyright (c) 2024-2025 Xiongfei Shi
+ *
+ * Author: Xiongfei Shi <xiongfei.shi(a)icloud.com>
+ * License: Apache-2.0
+ *
+ * https://github.com/shixiongfei/napi-talib
+ */
+
+#include "settings.h"
+#include "ta_thread.h"
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string.h>
+
+/* Every thread loads its settings into its own copy of the TA-Lib globals,
+ * only the interned copies and the defaults are shared */
+typedef struct SettingsTable {
+  std::mutex mutex;
+  std::list<TaSettings> interned;
+  const TaSettings *initial;
+  std::atomic<const TaSettings *> defaults;
+
+  SettingsTable() {
+    TaSettings settings;
+
+    /* TA_Initialize starts from zeroed globals */
+    memset(&settings, 0, sizeof(TaSettings));
+    interned.push_back(settings);
+
+    initial = &interned.back();
+    defaults = initial;
+  }
+} SettingsTable;
+
+static SettingsTable table;
+
+/* Settings in the calling thread's copy, nullptr until it has one */
+static thread_local const TaSettings *loaded = nullptr;
+
+TA_RetCode settingsSetUnstablePeriod(TaSettings *settings, TA_FuncUnstId funcId, unsigned int unstablePeriod) {
+  if (funcId < 0 || funcId > TA_FUNC_UNST_ALL)
+    return TA_BAD_PARAM;
+
+  if (funcId != TA_FUNC_UNST_ALL) {
+    settings->unstablePeriod[funcId] = unstablePeriod;
+    return TA_SUCCESS;
+  }
+
+  for (int i = 0; i < TA_FUNC_UNST_ALL; ++i)
+    settings->unstablePeriod[i] = unstablePeriod;
+
+  return TA_SUCCESS;
+}
+
+TA_RetCode settingsSetCompatibility(TaSettings *settings, TA_Compatibility value) {
+  if (value != TA_COMPATIBILITY_DEFAULT && value != TA_COMPATIBILITY_METASTOCK)
+    return TA_BAD_PARAM;
+
+  settings->compatibility = value;
+  return TA_SUCCESS;
+}
+
+static const TaSettings *internSettings(const TaSettings *settings) {
+  for (auto iter = table.interned.begin(); iter != table.interned.end(); iter++)
+    if (memcmp(&*iter, settings, sizeof(TaSettings)) == 0)
+      return &*iter;
+
+  table.interned.push_back(*settings);
+  return &table.interned.back();
+}
+
+const TaSettings *settingsIntern(const TaSettings *settings) {
+  std::lock_guard<std::mutex> lock(table.mutex);
+
+  return internSettings(settings);
+}
+
+const TaSettings *settingsDefault(void) {
+  return table.defaults.load(std::memory_order_acquire);
+}
+
+TA_RetCode settingsSetDefaultUnstablePeriod(TA_FuncUnstId funcId, unsigned int unstablePeriod) {
+  std::lock_guard<std::mutex> lock(table.mutex);
+  TaSettings settings = *table.defaults.load(std::memory_order_relaxed);
+  TA_RetCode retCode;
+
+  if (TA_SUCCESS != (retCode = settingsSetUnstablePeriod(&settings, funcId, unstablePeriod)))
+    return retCode;
+
+  table.defaults.store(internSettings(&settings), std::memory_order_release);
+  return TA_SUCCESS;
+}
+
+TA_RetCode settingsSetDefaultCompatibility(TA_Compatibility value) {
+  std::lock_guard<std::mutex> lock(table.mutex);
+  TaSettings settings = *table.defaults.load(std::memory_order_relaxed);
+  TA_RetCode retCode;
+
+  if (TA_SUCCESS != (retCode = settingsSetCompatibility(&settings, value)))
+    return retCode;
+
+  table.defaults.store(internSettings(&settings), std::memory_order_release);
+  return TA_SUCCESS;
+}
+
+/* The setters live in the TA-Lib sources, so they write the thread's copy */
+static void loadSettings(const TaSettings *from, const TaSettings *to) {
+  for (int i = 0; i < TA_FUNC_UNST_ALL; ++i)
+    if (from->unstablePeriod[i] != to->unstablePeriod[i])
+      TA_SetUnstablePeriod((TA_FuncUnstId)i, to->unstablePeriod[i]);
+
+  if (from->compatibility != to->compatibility)
+    TA_SetCompatibility(to->compatibility);
+}
+
+void settingsLoad(const TaSettings *settings) {
+  if (!settings)
+    settings = settingsDefault();
+
+  if (!loaded) {
+    taThreadAttach();
+    loaded = table.initial;
+  }
+
+  if (loaded != settings) {
+    loadSettings(loaded, settings);
+    loaded = settings;
+  }
+}
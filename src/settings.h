@@ -0,0 +1,41 @@
+/*
+ * settings.h
+ *
+ * Copyright (c) 2024-2025 Xiongfei Shi
+ *
+ * Author: Xiongfei Shi <xiongfei.shi(a)icloud.com>
+ * License: Apache-2.0
+ *
+ * https://github.com/shixiongfei/napi-talib
+ */
+
+#ifndef NAPI_TALIB_SETTINGS_H
+#define NAPI_TALIB_SETTINGS_H
+
+#include "ta_func.h"
+
+/* TA-Lib's global unstable periods and compatibility */
+typedef struct TaSettings {
+  TA_Compatibility compatibility;
+  unsigned int unstablePeriod[TA_FUNC_UNST_ALL];
+} TaSettings;
+
+/* Change a copy of the settings, TA_FUNC_UNST_ALL sets every period */
+TA_RetCode settingsSetUnstablePeriod(TaSettings *settings, TA_FuncUnstId funcId, unsigned int unstablePeriod);
+TA_RetCode settingsSetCompatibility(TaSettings *settings, TA_Compatibility value);
+
+/* Shared immutable copy, equal settings return the same pointer. Copies live
+ * until exit, there is one per distinct combination in use. */
+const TaSettings *settingsIntern(const TaSettings *settings);
+
+/* Settings of calls that do not bring their own */
+const TaSettings *settingsDefault(void);
+TA_RetCode settingsSetDefaultUnstablePeriod(TA_FuncUnstId funcId, unsigned int unstablePeriod);
+TA_RetCode settingsSetDefaultCompatibility(TA_Compatibility value);
+
+/* Load settings into the calling thread's copy of the TA-Lib globals,
+ * nullptr means the defaults. They stay loaded until the thread loads other
+ * settings, threads never wait on each other. */
+void settingsLoad(const TaSettings *settings);
+
+#endif
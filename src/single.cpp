@@ -0,0 +1,162 @@
+/*
+ * single.cpp
+ *
+ * Copyright (c) 2024-2025 Xiongfei Shi
+ *
+ * Author: Xiongfei Shi <xiongfei.shi(a)icloud.com>
+ * License: Apache-2.0
+ *
+ * https://github.com/shixiongfei/napi-talib
+ */
+
+#include "single.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define OPT_INT(i) ((int)opt[i])
+#define OPT_REAL(i) (opt[i])
+#define OPT_MA(i) ((TA_MAType)(int)opt[i])
+
+#define SINGLE(name, ...)                                                                                                                                       \
+  static TA_RetCode single##name(int startIdx, int endIdx, const float *const *in, const double *opt, int *outBegIdx, int *outNBElement, double *const *out) { \
+    return TA_S_##name(startIdx, endIdx, __VA_ARGS__);                                                                                                         \
+  }
+
+/* Functions with real outputs that show up in universe scans */
+SINGLE(AD, in[0], in[1], in[2], in[3], outBegIdx, outNBElement, out[0])
+SINGLE(ADOSC, in[0], in[1], in[2], in[3], OPT_INT(0), OPT_INT(1), outBegIdx, outNBElement, out[0])
+SINGLE(ADX, in[0], in[1], in[2], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(ADXR, in[0], in[1], in[2], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(APO, in[0], OPT_INT(0), OPT_INT(1), OPT_MA(2), outBegIdx, outNBElement, out[0])
+SINGLE(AROON, in[0], in[1], OPT_INT(0), outBegIdx, outNBElement, out[0], out[1])
+SINGLE(AROONOSC, in[0], in[1], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(ATR, in[0], in[1], in[2], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(AVGPRICE, in[0], in[1], in[2], in[3], outBegIdx, outNBElement, out[0])
+SINGLE(BBANDS, in[0], OPT_INT(0), OPT_REAL(1), OPT_REAL(2), OPT_MA(3), outBegIdx, outNBElement, out[0], out[1], out[2])
+SINGLE(BOP, in[0], in[1], in[2], in[3], outBegIdx, outNBElement, out[0])
+SINGLE(CCI, in[0], in[1], in[2], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(CMO, in[0], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(DEMA, in[0], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(DX, in[0], in[1], in[2], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(EMA, in[0], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(KAMA, in[0], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(LINEARREG, in[0], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(LINEARREG_ANGLE, in[0], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(LINEARREG_INTERCEPT, in[0], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(LINEARREG_SLOPE, in[0], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(MA, in[0], OPT_INT(0), OPT_MA(1), outBegIdx, outNBElement, out[0])
+SINGLE(MACD, in[0], OPT_INT(0), OPT_INT(1), OPT_INT(2), outBegIdx, outNBElement, out[0], out[1], out[2])
+SINGLE(MAX, in[0], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(MEDPRICE, in[0], in[1], outBegIdx, outNBElement, out[0])
+SINGLE(MFI, in[0], in[1], in[2], in[3], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(MIDPOINT, in[0], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(MIDPRICE, in[0], in[1], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(MIN, in[0], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(MINUS_DI, in[0], in[1], in[2], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(MINUS_DM, in[0], in[1], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(MOM, in[0], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(NATR, in[0], in[1], in[2], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(OBV, in[0], in[1], outBegIdx, outNBElement, out[0])
+SINGLE(PLUS_DI, in[0], in[1], in[2], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(PLUS_DM, in[0], in[1], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(PPO, in[0], OPT_INT(0), OPT_INT(1), OPT_MA(2), outBegIdx, outNBElement, out[0])
+SINGLE(ROC, in[0], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(ROCP, in[0], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(ROCR, in[0], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(ROCR100, in[0], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(RSI, in[0], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(SAR, in[0], in[1], OPT_REAL(0), OPT_REAL(1), outBegIdx, outNBElement, out[0])
+SINGLE(SMA, in[0], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(STDDEV, in[0], OPT_INT(0), OPT_REAL(1), outBegIdx, outNBElement, out[0])
+SINGLE(STOCH, in[0], in[1], in[2], OPT_INT(0), OPT_INT(1), OPT_MA(2), OPT_INT(3), OPT_MA(4), outBegIdx, outNBElement, out[0], out[1])
+SINGLE(SUM, in[0], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(T3, in[0], OPT_INT(0), OPT_REAL(1), outBegIdx, outNBElement, out[0])
+SINGLE(TEMA, in[0], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(TRANGE, in[0], in[1], in[2], outBegIdx, outNBElement, out[0])
+SINGLE(TRIMA, in[0], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(TRIX, in[0], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(TSF, in[0], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(TYPPRICE, in[0], in[1], in[2], outBegIdx, outNBElement, out[0])
+SINGLE(ULTOSC, in[0], in[1], in[2], OPT_INT(0), OPT_INT(1), OPT_INT(2), outBegIdx, outNBElement, out[0])
+SINGLE(VAR, in[0], OPT_INT(0), OPT_REAL(1), outBegIdx, outNBElement, out[0])
+SINGLE(WCLPRICE, in[0], in[1], in[2], outBegIdx, outNBElement, out[0])
+SINGLE(WILLR, in[0], in[1], in[2], OPT_INT(0), outBegIdx, outNBElement, out[0])
+SINGLE(WMA, in[0], OPT_INT(0), outBegIdx, outNBElement, out[0])
+
+typedef struct SingleEntry {
+  const char *name;
+  SingleFunc func;
+} SingleEntry;
+
+/* Sorted by name */
+static const SingleEntry singleFuncs[] = {
+    {"AD", singleAD},
+    {"ADOSC", singleADOSC},
+    {"ADX", singleADX},
+    {"ADXR", singleADXR},
+    {"APO", singleAPO},
+    {"AROON", singleAROON},
+    {"AROONOSC", singleAROONOSC},
+    {"ATR", singleATR},
+    {"AVGPRICE", singleAVGPRICE},
+    {"BBANDS", singleBBANDS},
+    {"BOP", singleBOP},
+    {"CCI", singleCCI},
+    {"CMO", singleCMO},
+    {"DEMA", singleDEMA},
+    {"DX", singleDX},
+    {"EMA", singleEMA},
+    {"KAMA", singleKAMA},
+    {"LINEARREG", singleLINEARREG},
+    {"LINEARREG_ANGLE", singleLINEARREG_ANGLE},
+    {"LINEARREG_INTERCEPT", singleLINEARREG_INTERCEPT},
+    {"LINEARREG_SLOPE", singleLINEARREG_SLOPE},
+    {"MA", singleMA},
+    {"MACD", singleMACD},
+    {"MAX", singleMAX},
+    {"MEDPRICE", singleMEDPRICE},
+    {"MFI", singleMFI},
+    {"MIDPOINT", singleMIDPOINT},
+    {"MIDPRICE", singleMIDPRICE},
+    {"MIN", singleMIN},
+    {"MINUS_DI", singleMINUS_DI},
+    {"MINUS_DM", singleMINUS_DM},
+    {"MOM", singleMOM},
+    {"NATR", singleNATR},
+    {"OBV", singleOBV},
+    {"PLUS_DI", singlePLUS_DI},
+    {"PLUS_DM", singlePLUS_DM},
+    {"PPO", singlePPO},
+    {"ROC", singleROC},
+    {"ROCP", singleROCP},
+    {"ROCR", singleROCR},
+    {"ROCR100", singleROCR100},
+    {"RSI", singleRSI},
+    {"SAR", singleSAR},
+    {"SMA", singleSMA},
+    {"STDDEV", singleSTDDEV},
+    {"STOCH", singleSTOCH},
+    {"SUM", singleSUM},
+    {"T3", singleT3},
+    {"TEMA", singleTEMA},
+    {"TRANGE", singleTRANGE},
+    {"TRIMA", singleTRIMA},
+    {"TRIX", singleTRIX},
+    {"TSF", singleTSF},
+    {"TYPPRICE", singleTYPPRICE},
+    {"ULTOSC", singleULTOSC},
+    {"VAR", singleVAR},
+    {"WCLPRICE", singleWCLPRICE},
+    {"WILLR", singleWILLR},
+    {"WMA", singleWMA},
+};
+
+static int compareEntry(const void *key, const void *entry) {
+  return strcmp((const char *)key, ((const SingleEntry *)entry)->name);
+}
+
+SingleFunc singleFind(const char *funcName) {
+  const SingleEntry *entry = (const SingleEntry *)bsearch(funcName, singleFuncs, sizeof(singleFuncs) / sizeof(singleFuncs[0]), sizeof(SingleEntry), compareEntry);
+
+  return entry ? entry->func : nullptr;
+}
@@ -0,0 +1,24 @@
+/*
+ * single.h
+ *
+ * Copyright (c) 2024-2025 Xiongfei Shi
+ *
+ * Author: Xiongfei Shi <xiongfei.shi(a)icloud.com>
+ * License: Apache-2.0
+ *
+ * https://github.com/shixiongfei/napi-talib
+ */
+
+#ifndef NAPI_TALIB_SINGLE_H
+#define NAPI_TALIB_SINGLE_H
+
+#include "ta_func.h"
+
+/* Inputs follow the TA-Lib inputs with prices expanded in open, high, low,
+ * close, volume, openInterest order, optInputs are in TA-Lib order. */
+typedef TA_RetCode (*SingleFunc)(int startIdx, int endIdx, const float *const *inputs, const double *optInputs, int *outBegIdx, int *outNBElement, double *const *outputs);
+
+/* TA_S_* entry point reading float inputs, nullptr if funcName has none */
+SingleFunc singleFind(const char *funcName);
+
+#endif
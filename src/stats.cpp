@@ -0,0 +1,90 @@
+/*
+ * stats.cpp
+ *
+ * Copyright (c) 2024-2025 Xiongfei Shi
+ *
+ * Author: Xiongfei Shi <xiongfei.shi(a)icloud.com>
+ * License: Apache-2.0
+ *
+ * https://github.com/shixiongfei/napi-talib
+ */
+
+#include "stats.h"
+#include <atomic>
+#include <map>
+#include <math.h>
+#include <mutex>
+#include <string.h>
+#include <string>
+
+typedef struct Stats {
+  std::atomic<bool> enabled;
+  std::mutex mutex;
+  std::map<std::string, FuncStats> funcs;
+} Stats;
+
+static Stats stats;
+
+void statsSetEnabled(bool enabled) {
+  stats.enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool statsEnabled(void) {
+  return stats.enabled.load(std::memory_order_relaxed);
+}
+
+static void addSample(StatsHistogram *histogram, int64_t nanoseconds) {
+  double microseconds = nanoseconds / 1000.0;
+  int index = 0;
+
+  if (nanoseconds < 0)
+    return;
+
+  while (index < STATS_BUCKETS - 1 && microseconds > statsBucketBound(index))
+    index += 1;
+
+  histogram->count += 1;
+  histogram->sum += microseconds;
+  histogram->buckets[index] += 1;
+}
+
+void statsRecord(const char *funcName, const StatsSample *sample) {
+  if (!statsEnabled())
+    return;
+
+  std::lock_guard<std::mutex> lock(stats.mutex);
+  auto iter = stats.funcs.find(funcName);
+
+  if (iter == stats.funcs.end()) {
+    FuncStats funcStats;
+
+    memset(&funcStats, 0, sizeof(funcStats));
+    iter = stats.funcs.emplace(funcName, funcStats).first;
+  }
+
+  iter->second.calls += 1;
+  iter->second.elements += sample->elements;
+  iter->second.inputBytes += sample->inputBytes;
+
+  addSample(&iter->second.parse, sample->parseTime);
+  addSample(&iter->second.compute, sample->computeTime);
+  addSample(&iter->second.marshal, sample->marshalTime);
+  addSample(&iter->second.queueWait, sample->queueTime);
+}
+
+void statsForEach(void (*callback)(const char *funcName, const FuncStats *funcStats, void *data), void *data) {
+  std::lock_guard<std::mutex> lock(stats.mutex);
+
+  for (auto iter = stats.funcs.begin(); iter != stats.funcs.end(); iter++)
+    callback(iter->first.c_str(), &iter->second, data);
+}
+
+void statsReset(void) {
+  std::lock_guard<std::mutex> lock(stats.mutex);
+
+  stats.funcs.clear();
+}
+
+double statsBucketBound(int index) {
+  return index < STATS_BUCKETS - 1 ? ldexp(1.0, index) : INFINITY;
+}
@@ -0,0 +1,60 @@
+/*
+ * stats.h
+ *
+ * Copyright (c) 2024-2025 Xiongfei Shi
+ *
+ * Author: Xiongfei Shi <xiongfei.shi(a)icloud.com>
+ * License: Apache-2.0
+ *
+ * https://github.com/shixiongfei/napi-talib
+ */
+
+#ifndef NAPI_TALIB_STATS_H
+#define NAPI_TALIB_STATS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Bucket i counts the samples up to 2^i microseconds, the last one the rest */
+#define STATS_BUCKETS 24
+
+typedef struct StatsHistogram {
+  int64_t count;
+  double sum;
+  int64_t buckets[STATS_BUCKETS];
+} StatsHistogram;
+
+typedef struct FuncStats {
+  int64_t calls;
+  int64_t elements;
+  int64_t inputBytes;
+  StatsHistogram parse;
+  StatsHistogram compute;
+  StatsHistogram marshal;
+  StatsHistogram queueWait;
+} FuncStats;
+
+/* Times are in nanoseconds, negative when the phase was not measured */
+typedef struct StatsSample {
+  int64_t elements;
+  int64_t inputBytes;
+  int64_t parseTime;
+  int64_t computeTime;
+  int64_t marshalTime;
+  int64_t queueTime;
+} StatsSample;
+
+/* Off by default, statsRecord is a single load while disabled */
+void statsSetEnabled(bool enabled);
+bool statsEnabled(void);
+
+void statsRecord(const char *funcName, const StatsSample *sample);
+
+/* Functions in name order, under the stats lock */
+void statsForEach(void (*callback)(const char *funcName, const FuncStats *funcStats, void *data), void *data);
+void statsReset(void);
+
+/* Upper bound of a bucket in microseconds, INFINITY for the last one */
+double statsBucketBound(int index);
+
+#endif
@@ -0,0 +1,858 @@
+/*
+ * stream.cpp
+ *
+ * Copyright (c) 2024-2025 Xiongfei Shi
+ *
+ * Author: Xiongfei Shi <xiongfei.shi(a)icloud.com>
+ * License: Apache-2.0
+ *
+ * https://github.com/shixiongfei/napi-talib
+ */
+
+#include "stream.h"
+#include "ta_func.h"
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+
+/* The state machines below repeat the arithmetic of the TA-Lib sources
+ * operation by operation, so every value is bit-identical to TA_CallFunc
+ * over the whole history. */
+
+#define IS_ZERO(v) (((-0.00000001) < (v)) && ((v) < 0.00000001))
+#define IS_ZERO_OR_NEG(v) ((v) < 0.00000001)
+#define PER_TO_K(per) ((double)2.0 / ((double)((per) + 1)))
+
+typedef enum StreamKind {
+  STREAM_SMA,
+  STREAM_EMA,
+  STREAM_WMA,
+  STREAM_RSI,
+  STREAM_TRANGE,
+  STREAM_ATR,
+  STREAM_ADX,
+  STREAM_MACD,
+  STREAM_BBANDS,
+  STREAM_STOCH,
+  STREAM_OBV,
+  STREAM_SAR,
+} StreamKind;
+
+/* Rings are written at slot count % period only, so restoring the scalars
+ * is enough to replay the last bar. */
+typedef struct StreamSma {
+  int period;
+  int64_t count;
+  double total;
+  double *ring;
+} StreamSma;
+
+typedef struct StreamEma {
+  int period;
+  double k;
+  bool metastock;
+  int64_t count;
+  double sum;
+  double value;
+} StreamEma;
+
+typedef struct StreamWma {
+  int period;
+  int64_t count;
+  double periodSum;
+  double periodSub;
+  double trailingValue;
+  double *ring;
+} StreamWma;
+
+/* Moving average as computed through TA_MA, only SMA and EMA */
+typedef struct StreamMa {
+  int type;
+  int lookback;
+  int64_t count;
+  StreamSma sma;
+  StreamEma ema;
+} StreamMa;
+
+typedef struct StreamCore {
+  int period;
+  StreamSma sma;
+  StreamEma ema;
+  StreamWma wma;
+
+  /* RSI */
+  bool metastockSeed;
+  double prevValue;
+  double prevGain;
+  double prevLoss;
+
+  /* TRANGE, ATR, ADX */
+  double prevHigh;
+  double prevLow;
+  double prevClose;
+  double prevMinusDM;
+  double prevPlusDM;
+  double prevTR;
+  double sumDX;
+  double prevADX;
+  double sum;
+  double prevATR;
+
+  /* MACD */
+  int fastStart;
+  int macdStart;
+  StreamEma fast;
+  StreamEma slow;
+  StreamEma signal;
+
+  /* BBANDS */
+  double nbDevUp;
+  double nbDevDn;
+  double total2;
+
+  /* STOCH */
+  double *highs;
+  double *lows;
+  StreamMa slowK;
+  StreamMa slowD;
+
+  /* OBV */
+  double prevOBV;
+  double prevReal;
+
+  /* SAR */
+  double acceleration;
+  double maximum;
+  bool isLong;
+  double sar;
+  double ep;
+  double af;
+  double newHigh;
+  double newLow;
+} StreamCore;
+
+struct Stream {
+  StreamKind kind;
+  int lookback;
+  int nbOutput;
+  int64_t count;
+  StreamCore core;
+  StreamCore saved;
+  std::vector<double> storage;
+};
+
+static bool smaPush(StreamSma *sma, double value, double *out) {
+  double total;
+
+  sma->ring[sma->count % sma->period] = value;
+
+  if (sma->count++ < sma->period - 1) {
+    sma->total += value;
+    return false;
+  }
+
+  total = sma->total + value;
+  sma->total = total - sma->ring[(sma->count - sma->period) % sma->period];
+  *out = total / sma->period;
+
+  return true;
+}
+
+static bool emaPush(StreamEma *ema, double value, double *out) {
+  if (ema->metastock) {
+    /* Metastock starts from the first value instead of a SMA */
+    ema->value = ema->count++ == 0 ? value : ((value - ema->value) * ema->k) + ema->value;
+  } else if (ema->count < ema->period) {
+    ema->sum += value;
+
+    if (++ema->count < ema->period)
+      return false;
+
+    ema->value = ema->sum / ema->period;
+  } else {
+    ema->count++;
+    ema->value = ((value - ema->value) * ema->k) + ema->value;
+  }
+
+  *out = ema->value;
+  return true;
+}
+
+static bool wmaPush(StreamWma *wma, double value, double *out) {
+  int divider = (wma->period * (wma->period + 1)) >> 1;
+
+  wma->ring[wma->count % wma->period] = value;
+
+  if (wma->period == 1) {
+    wma->count++;
+    *out = value;
+    return true;
+  }
+
+  if (wma->count < wma->period - 1) {
+    wma->periodSub += value;
+    wma->periodSum += value * (wma->count + 1);
+    wma->count++;
+    return false;
+  }
+
+  wma->periodSub += value;
+  wma->periodSub -= wma->trailingValue;
+  wma->periodSum += value * wma->period;
+  wma->trailingValue = wma->ring[(wma->count - wma->period + 1) % wma->period];
+  *out = wma->periodSum / divider;
+  wma->periodSum -= wma->periodSub;
+  wma->count++;
+
+  return true;
+}
+
+/* TA_MA returns the input as is for a period of 1 */
+static bool maPush(StreamMa *ma, double value, double *out) {
+  int64_t index = ma->count++;
+
+  if (ma->sma.period == 1) {
+    *out = value;
+    return true;
+  }
+
+  if (ma->type == 0)
+    smaPush(&ma->sma, value, out);
+  else
+    emaPush(&ma->ema, value, out);
+
+  /* Like TA_MA, EMA values inside the unstable period are not passed on */
+  return index >= ma->lookback;
+}
+
+static void initSma(StreamSma *sma, int period, double *ring) {
+  sma->period = period;
+  sma->count = 0;
+  sma->total = 0.0;
+  sma->ring = ring;
+}
+
+static void initEma(StreamEma *ema, int period, bool metastock) {
+  ema->period = period;
+  ema->k = PER_TO_K(period);
+  ema->metastock = metastock;
+  ema->count = 0;
+  ema->sum = 0.0;
+  ema->value = 0.0;
+}
+
+static void initMa(StreamMa *ma, int period, int type, bool metastock, int emaUnstable, double *ring) {
+  ma->type = type;
+  ma->count = 0;
+  ma->lookback = period <= 1 ? 0 : type == 0 ? period - 1 : period - 1 + emaUnstable;
+  initSma(&ma->sma, period, ring);
+  initEma(&ma->ema, period, metastock);
+}
+
+static double trueRange(double high, double low, double prevClose) {
+  double greatest = high - low;
+  double value;
+
+  value = fabs(prevClose - high);
+
+  if (value > greatest)
+    greatest = value;
+
+  value = fabs(prevClose - low);
+
+  if (value > greatest)
+    greatest = value;
+
+  return greatest;
+}
+
+static void stepRsi(StreamCore *core, int64_t n, double value, double *out) {
+  int period = core->period;
+  double diff, total;
+
+  if (period == 1) {
+    *out = value;
+    return;
+  }
+
+  if (n == 0) {
+    core->prevValue = value;
+    core->prevGain = 0.0;
+    core->prevLoss = 0.0;
+    return;
+  }
+
+  diff = value - core->prevValue;
+  core->prevValue = value;
+
+  if (n <= period) {
+    if (diff < 0)
+      core->prevLoss -= diff;
+    else
+      core->prevGain += diff;
+
+    /* Metastock emits one more value, from the partial sums */
+    if (n == period - 1 && core->metastockSeed) {
+      double loss = core->prevLoss / period;
+      double gain = core->prevGain / period;
+
+      total = gain + loss;
+      *out = !IS_ZERO(total) ? 100 * (gain / total) : 0.0;
+
+      return;
+    }
+
+    if (n < period)
+      return;
+
+    core->prevLoss /= period;
+    core->prevGain /= period;
+  } else {
+    core->prevLoss *= (period - 1);
+    core->prevGain *= (period - 1);
+
+    if (diff < 0)
+      core->prevLoss -= diff;
+    else
+      core->prevGain += diff;
+
+    core->prevLoss /= period;
+    core->prevGain /= period;
+  }
+
+  total = core->prevGain + core->prevLoss;
+  *out = !IS_ZERO(total) ? 100.0 * (core->prevGain / total) : 0.0;
+}
+
+static void stepAtr(StreamCore *core, int64_t n, const double *bar, double *out) {
+  int period = core->period;
+  double tr;
+
+  if (n == 0) {
+    core->prevClose = bar[2];
+    core->sum = 0.0;
+    return;
+  }
+
+  tr = trueRange(bar[0], bar[1], core->prevClose);
+  core->prevClose = bar[2];
+
+  if (period <= 1) {
+    *out = tr;
+    return;
+  }
+
+  if (n <= period) {
+    core->sum += tr;
+
+    if (n == period)
+      *out = core->prevATR = core->sum / period;
+
+    return;
+  }
+
+  core->prevATR *= period - 1;
+  core->prevATR += tr;
+  core->prevATR /= period;
+  *out = core->prevATR;
+}
+
+static void stepAdx(StreamCore *core, int64_t n, const double *bar, double *out) {
+  int period = core->period;
+  double diffP, diffM, tr, minusDI, plusDI, total, dx = 0.0;
+  bool hasDX = false;
+
+  if (n == 0) {
+    core->prevHigh = bar[0];
+    core->prevLow = bar[1];
+    core->prevClose = bar[2];
+    core->prevMinusDM = 0.0;
+    core->prevPlusDM = 0.0;
+    core->prevTR = 0.0;
+    core->sumDX = 0.0;
+    return;
+  }
+
+  diffP = bar[0] - core->prevHigh;
+  core->prevHigh = bar[0];
+  diffM = core->prevLow - bar[1];
+  core->prevLow = bar[1];
+
+  if (n >= period) {
+    core->prevMinusDM -= core->prevMinusDM / period;
+    core->prevPlusDM -= core->prevPlusDM / period;
+  }
+
+  if ((diffM > 0) && (diffP < diffM))
+    core->prevMinusDM += diffM;
+  else if ((diffP > 0) && (diffP > diffM))
+    core->prevPlusDM += diffP;
+
+  tr = trueRange(core->prevHigh, core->prevLow, core->prevClose);
+
+  if (n < period)
+    core->prevTR += tr;
+  else
+    core->prevTR = core->prevTR - (core->prevTR / period) + tr;
+
+  core->prevClose = bar[2];
+
+  if (n < period)
+    return;
+
+  if (!IS_ZERO(core->prevTR)) {
+    minusDI = 100.0 * (core->prevMinusDM / core->prevTR);
+    plusDI = 100.0 * (core->prevPlusDM / core->prevTR);
+    total = minusDI + plusDI;
+
+    if (!IS_ZERO(total)) {
+      dx = 100.0 * (fabs(minusDI - plusDI) / total);
+      hasDX = true;
+    }
+  }
+
+  if (n < 2 * period) {
+    if (hasDX)
+      core->sumDX += dx;
+
+    if (n == 2 * period - 1)
+      *out = core->prevADX = core->sumDX / period;
+
+    return;
+  }
+
+  if (hasDX)
+    core->prevADX = ((core->prevADX * (period - 1)) + dx) / period;
+
+  *out = core->prevADX;
+}
+
+static void stepMacd(StreamCore *core, int64_t n, double value, double *out) {
+  double fast = 0.0, slow = 0.0, signal;
+
+  emaPush(&core->slow, value, &slow);
+
+  if (n >= core->fastStart)
+    emaPush(&core->fast, value, &fast);
+
+  if (n < core->macdStart)
+    return;
+
+  out[0] = fast - slow;
+
+  if (emaPush(&core->signal, out[0], &signal)) {
+    out[1] = signal;
+    out[2] = out[0] - signal;
+  }
+}
+
+static void stepBbands(StreamCore *core, int64_t n, double value, double *out) {
+  StreamSma *sma = &core->sma;
+  double middle, square, mean2, stddev;
+
+  square = value * value;
+
+  if (!smaPush(sma, value, &middle)) {
+    core->total2 += square;
+    return;
+  }
+
+  core->total2 += square;
+  mean2 = core->total2 / sma->period;
+
+  square = sma->ring[(sma->count - sma->period) % sma->period];
+  square *= square;
+  core->total2 -= square;
+
+  mean2 -= middle * middle;
+  stddev = !IS_ZERO_OR_NEG(mean2) ? sqrt(mean2) : (double)0.0;
+
+  out[0] = middle + stddev * core->nbDevUp;
+  out[1] = middle;
+  out[2] = middle - stddev * core->nbDevDn;
+}
+
+static void stepStoch(StreamCore *core, int64_t n, const double *bar, double *out) {
+  int period = core->period;
+  double lowest, highest, diff, fastK, slowK, slowD;
+
+  core->highs[n % period] = bar[0];
+  core->lows[n % period] = bar[1];
+
+  if (n < period - 1)
+    return;
+
+  lowest = core->lows[0];
+  highest = core->highs[0];
+
+  for (int i = 1; i < period; ++i) {
+    if (core->lows[i] < lowest)
+      lowest = core->lows[i];
+
+    if (core->highs[i] > highest)
+      highest = core->highs[i];
+  }
+
+  diff = (highest - lowest) / 100.0;
+  fastK = diff != 0.0 ? (bar[2] - lowest) / diff : 0.0;
+
+  if (!maPush(&core->slowK, fastK, &slowK))
+    return;
+
+  if (!maPush(&core->slowD, slowK, &slowD))
+    return;
+
+  out[0] = slowK;
+  out[1] = slowD;
+}
+
+static void stepObv(StreamCore *core, int64_t n, const double *bar, double *out) {
+  if (n == 0) {
+    core->prevOBV = bar[1];
+    core->prevReal = bar[0];
+  }
+
+  if (bar[0] > core->prevReal)
+    core->prevOBV += bar[1];
+  else if (bar[0] < core->prevReal)
+    core->prevOBV -= bar[1];
+
+  core->prevReal = bar[0];
+  *out = core->prevOBV;
+}
+
+static void stepSar(StreamCore *core, int64_t n, const double *bar, double *out) {
+  double newHigh = bar[0];
+  double newLow = bar[1];
+  double prevHigh, prevLow, diffP, diffM;
+
+  if (n == 0) {
+    core->newHigh = newHigh;
+    core->newLow = newLow;
+    return;
+  }
+
+  /* The initial direction comes from MINUS_DM over the first two bars */
+  if (n == 1) {
+    diffP = newHigh - core->newHigh;
+    diffM = core->newLow - newLow;
+    core->isLong = !((diffM > 0) && (diffP < diffM));
+
+    if (core->isLong) {
+      core->ep = newHigh;
+      core->sar = core->newLow;
+    } else {
+      core->ep = newLow;
+      core->sar = core->newHigh;
+    }
+
+    core->af = core->acceleration;
+    core->newHigh = newHigh;
+    core->newLow = newLow;
+  }
+
+  prevLow = core->newLow;
+  prevHigh = core->newHigh;
+  core->newLow = newLow;
+  core->newHigh = newHigh;
+
+  if (core->isLong) {
+    if (newLow <= core->sar) {
+      core->isLong = false;
+      core->sar = core->ep;
+
+      if (core->sar < prevHigh)
+        core->sar = prevHigh;
+      if (core->sar < newHigh)
+        core->sar = newHigh;
+
+      *out = core->sar;
+
+      core->af = core->acceleration;
+      core->ep = newLow;
+      core->sar = core->sar + core->af * (core->ep - core->sar);
+
+      if (core->sar < prevHigh)
+        core->sar = prevHigh;
+      if (core->sar < newHigh)
+        core->sar = newHigh;
+    } else {
+      *out = core->sar;
+
+      if (newHigh > core->ep) {
+        core->ep = newHigh;
+        core->af += core->acceleration;
+
+        if (core->af > core->maximum)
+          core->af = core->maximum;
+      }
+
+      core->sar = core->sar + core->af * (core->ep - core->sar);
+
+      if (core->sar > prevLow)
+        core->sar = prevLow;
+      if (core->sar > newLow)
+        core->sar = newLow;
+    }
+  } else {
+    if (newHigh >= core->sar) {
+      core->isLong = true;
+      core->sar = core->ep;
+
+      if (core->sar > prevLow)
+        core->sar = prevLow;
+      if (core->sar > newLow)
+        core->sar = newLow;
+
+      *out = core->sar;
+
+      core->af = core->acceleration;
+      core->ep = newHigh;
+      core->sar = core->sar + core->af * (core->ep - core->sar);
+
+      if (core->sar > prevLow)
+        core->sar = prevLow;
+      if (core->sar > newLow)
+        core->sar = newLow;
+    } else {
+      *out = core->sar;
+
+      if (newLow < core->ep) {
+        core->ep = newLow;
+        core->af += core->acceleration;
+
+        if (core->af > core->maximum)
+          core->af = core->maximum;
+      }
+
+      core->sar = core->sar + core->af * (core->ep - core->sar);
+
+      if (core->sar < prevHigh)
+        core->sar = prevHigh;
+      if (core->sar < newHigh)
+        core->sar = newHigh;
+    }
+  }
+}
+
+static void stepStream(Stream *stream, int64_t n, const double *bar, double *outputs) {
+  StreamCore *core = &stream->core;
+  double value;
+
+  for (int i = 0; i < stream->nbOutput; ++i)
+    outputs[i] = NAN;
+
+  switch (stream->kind) {
+  case STREAM_SMA:
+    if (smaPush(&core->sma, bar[0], &value))
+      outputs[0] = value;
+    break;
+
+  case STREAM_EMA:
+    if (emaPush(&core->ema, bar[0], &value))
+      outputs[0] = value;
+    break;
+
+  case STREAM_WMA:
+    if (wmaPush(&core->wma, bar[0], &value))
+      outputs[0] = value;
+    break;
+
+  case STREAM_RSI:
+    stepRsi(core, n, bar[0], outputs);
+    break;
+
+  case STREAM_TRANGE:
+    if (n > 0)
+      outputs[0] = trueRange(bar[0], bar[1], core->prevClose);
+
+    core->prevClose = bar[2];
+    break;
+
+  case STREAM_ATR:
+    stepAtr(core, n, bar, outputs);
+    break;
+
+  case STREAM_ADX:
+    stepAdx(core, n, bar, outputs);
+    break;
+
+  case STREAM_MACD:
+    stepMacd(core, n, bar[0], outputs);
+    break;
+
+  case STREAM_BBANDS:
+    stepBbands(core, n, bar[0], outputs);
+    break;
+
+  case STREAM_STOCH:
+    stepStoch(core, n, bar, outputs);
+    break;
+
+  case STREAM_OBV:
+    stepObv(core, n, bar, outputs);
+    break;
+
+  case STREAM_SAR:
+    stepSar(core, n, bar, outputs);
+    break;
+  }
+
+  /* Values inside the unstable period are kept internal */
+  if (n < stream->lookback)
+    for (int i = 0; i < stream->nbOutput; ++i)
+      outputs[i] = NAN;
+}
+
+static const struct {
+  const char *name;
+  StreamKind kind;
+  int nbOutput;
+} streamKinds[] = {
+    {"SMA", STREAM_SMA, 1},
+    {"EMA", STREAM_EMA, 1},
+    {"WMA", STREAM_WMA, 1},
+    {"RSI", STREAM_RSI, 1},
+    {"TRANGE", STREAM_TRANGE, 1},
+    {"ATR", STREAM_ATR, 1},
+    {"ADX", STREAM_ADX, 1},
+    {"MACD", STREAM_MACD, 3},
+    {"BBANDS", STREAM_BBANDS, 3},
+    {"STOCH", STREAM_STOCH, 2},
+    {"OBV", STREAM_OBV, 1},
+    {"SAR", STREAM_SAR, 1},
+};
+
+Stream *streamCreate(const char *funcName, const double *optInputs, int nbOptInput, int lookback) {
+  Stream *stream = nullptr;
+  StreamCore *core;
+  bool supported = true;
+  bool metastock = TA_GetCompatibility() == TA_COMPATIBILITY_METASTOCK;
+  int emaUnstable = (int)TA_GetUnstablePeriod(TA_FUNC_UNST_EMA);
+
+  for (size_t i = 0; i < sizeof(streamKinds) / sizeof(*streamKinds); ++i) {
+    if (strcmp(funcName, streamKinds[i].name) != 0)
+      continue;
+
+    stream = new Stream();
+    stream->kind = streamKinds[i].kind;
+    stream->nbOutput = streamKinds[i].nbOutput;
+    break;
+  }
+
+  if (!stream)
+    return nullptr;
+
+  stream->lookback = lookback;
+  stream->count = 0;
+
+  core = &stream->core;
+  memset(core, 0, sizeof(StreamCore));
+  core->period = nbOptInput > 0 ? (int)optInputs[0] : 0;
+
+  switch (stream->kind) {
+  case STREAM_SMA:
+  case STREAM_BBANDS:
+    /* Only the SMA flavour of BBANDS shares its running sums with TA_MA */
+    if (stream->kind == STREAM_BBANDS && optInputs[3] != 0) {
+      supported = false;
+      break;
+    }
+
+    stream->storage.resize(core->period);
+    initSma(&core->sma, core->period, stream->storage.data());
+
+    if (stream->kind == STREAM_BBANDS) {
+      core->nbDevUp = optInputs[1];
+      core->nbDevDn = optInputs[2];
+    }
+    break;
+
+  case STREAM_EMA:
+    initEma(&core->ema, core->period, metastock);
+    break;
+
+  case STREAM_WMA:
+    stream->storage.resize(core->period);
+    core->wma.period = core->period;
+    core->wma.ring = stream->storage.data();
+    break;
+
+  case STREAM_RSI:
+    core->metastockSeed = metastock && TA_GetUnstablePeriod(TA_FUNC_UNST_RSI) == 0;
+    break;
+
+  case STREAM_MACD: {
+    int fastPeriod = (int)optInputs[0];
+    int slowPeriod = (int)optInputs[1];
+
+    if (slowPeriod < fastPeriod) {
+      int period = slowPeriod;
+
+      slowPeriod = fastPeriod;
+      fastPeriod = period;
+    }
+
+    initEma(&core->fast, fastPeriod, metastock);
+    initEma(&core->slow, slowPeriod, metastock);
+    initEma(&core->signal, (int)optInputs[2], metastock);
+
+    core->fastStart = metastock ? 0 : slowPeriod - fastPeriod;
+    core->macdStart = slowPeriod - 1 + emaUnstable;
+    break;
+  }
+
+  case STREAM_STOCH: {
+    int slowKPeriod = (int)optInputs[1];
+    int slowDPeriod = (int)optInputs[3];
+    int slowKType = (int)optInputs[2];
+    int slowDType = (int)optInputs[4];
+
+    if ((slowKType != 0 && slowKType != 1) || (slowDType != 0 && slowDType != 1)) {
+      supported = false;
+      break;
+    }
+
+    stream->storage.resize(2 * core->period + slowKPeriod + slowDPeriod);
+    core->highs = stream->storage.data();
+    core->lows = core->highs + core->period;
+
+    initMa(&core->slowK, slowKPeriod, slowKType, metastock, emaUnstable, core->lows + core->period);
+    initMa(&core->slowD, slowDPeriod, slowDType, metastock, emaUnstable, core->lows + core->period + slowKPeriod);
+    break;
+  }
+
+  case STREAM_SAR:
+    core->acceleration = optInputs[0];
+    core->maximum = optInputs[1];
+
+    if (core->acceleration > core->maximum)
+      core->acceleration = core->maximum;
+    break;
+
+  default:
+    break;
+  }
+
+  if (!supported) {
+    delete stream;
+    return nullptr;
+  }
+
+  return stream;
+}
+
+void streamFree(Stream *stream) {
+  delete stream;
+}
+
+void streamUpdate(Stream *stream, const double *bar, double *outputs) {
+  stream->saved = stream->core;
+  stepStream(stream, stream->count++, bar, outputs);
+}
+
+void streamReplaceLast(Stream *stream, const double *bar, double *outputs) {
+  stream->core = stream->saved;
+  stepStream(stream, stream->count - 1, bar, outputs);
+}
@@ -0,0 +1,32 @@
+/*
+ * stream.h
+ *
+ * Copyright (c) 2024-2025 Xiongfei Shi
+ *
+ * Author: Xiongfei Shi <xiongfei.shi(a)icloud.com>
+ * License: Apache-2.0
+ *
+ * https://github.com/shixiongfei/napi-talib
+ */
+
+#ifndef NAPI_TALIB_STREAM_H
+#define NAPI_TALIB_STREAM_H
+
+typedef struct Stream Stream;
+
+/* Incremental state machine replaying funcName bar by bar, nullptr if the
+ * function has none. optInputs are in TA-Lib order, lookback is the value
+ * returned by TA_GetLookback for the same parameters. The unstable periods
+ * and the compatibility are read once, here. */
+Stream *streamCreate(const char *funcName, const double *optInputs, int nbOptInput, int lookback);
+void streamFree(Stream *stream);
+
+/* Append a bar, the values follow the TA-Lib inputs with prices expanded in
+ * open, high, low, close, volume, openInterest order. Outputs before the
+ * lookback are NAN. */
+void streamUpdate(Stream *stream, const double *bar, double *outputs);
+
+/* Recompute the last appended bar with new values */
+void streamReplaceLast(Stream *stream, const double *bar, double *outputs);
+
+#endif
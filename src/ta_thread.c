@@ -0,0 +1,27 @@
+/*
+ * ta_thread.c
+ *
+ * Copyright (c) 2024-2025 Xiongfei Shi
+ *
+ * Author: Xiongfei Shi <xiongfei.shi(a)icloud.com>
+ * License: Apache-2.0
+ *
+ * https://github.com/shixiongfei/napi-talib
+ */
+
+#define NAPI_TALIB_TA_THREAD_C
+
+#include "ta_thread.h"
+#include "ta_global.h"
+#include <string.h>
+
+TA_THREAD_LOCAL TA_LibcPriv *taThreadGlobals;
+static TA_THREAD_LOCAL TA_LibcPriv taThreadCopy;
+
+void taThreadAttach(void) {
+  if (taThreadGlobals)
+    return;
+
+  memcpy(&taThreadCopy, TA_Globals, sizeof(TA_LibcPriv));
+  taThreadGlobals = &taThreadCopy;
+}
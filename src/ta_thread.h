@@ -0,0 +1,43 @@
+/*
+ * ta_thread.h
+ *
+ * Copyright (c) 2024-2025 Xiongfei Shi
+ *
+ * Author: Xiongfei Shi <xiongfei.shi(a)icloud.com>
+ * License: Apache-2.0
+ *
+ * https://github.com/shixiongfei/napi-talib
+ */
+
+#ifndef NAPI_TALIB_TA_THREAD_H
+#define NAPI_TALIB_TA_THREAD_H
+
+#if defined(_MSC_VER)
+#define TA_THREAD_LOCAL __declspec(thread)
+#else
+#define TA_THREAD_LOCAL __thread
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Gives the calling thread its own copy of the TA-Lib globals, taken from
+ * what TA_Initialize left in the process globals. Later calls do nothing. */
+void taThreadAttach(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/* Forced into the TA-Lib sources, which then read and write the copy of the
+ * attached thread. Threads that never attached keep the process globals. */
+#if !defined(__cplusplus) && !defined(NAPI_TALIB_TA_THREAD_C)
+#include "ta_global.h"
+
+extern TA_THREAD_LOCAL TA_LibcPriv *taThreadGlobals;
+
+#define TA_Globals (taThreadGlobals ? taThreadGlobals : TA_Globals)
+#endif
+
+#endif
@@ -10,8 +10,9 @@
  */
 
 import fs from "node:fs";
+import os from "node:os";
 import talib from "./index.js";
-import { ADX } from "./functions.js";
+import { ADX, SMA as SMA_SYNC } from "./functions.js";
 import { SMA, EMA } from "./promises.js";
 
 /*
@@ -25,7 +26,8 @@ import { SMA, EMA } from "./promises.js";
 
 const marketData = JSON.parse(fs.readFileSync("./marketdata.json", "utf8"));
 
-console.log(talib.version());
+console.log(talib.version(), talib.simd());
+talib.setStatsEnabled(true);
 
 console.log(talib.MAType.EMA);
 
@@ -39,6 +41,18 @@ console.log(talib.setCompatibility(talib.Compatibility.METASTOCK));
 
 console.log(talib.explain("ADX"));
 
+// Per call settings, other calls keep the defaults set above
+console.log(
+  talib.execute({
+    name: "EMA",
+    startIdx: 0,
+    endIdx: marketData.close.length - 1,
+    params: { inReal: marketData.close, optInTimePeriod: 30 },
+    unstablePeriod: { EMA: 10 },
+    compatibility: talib.Compatibility.DEFAULT,
+  })
+);
+
 console.log(
   // Synchronous call
   talib.execute({
@@ -54,6 +68,32 @@ console.log(
   })
 );
 
+console.log(
+  // Synchronous call, typed arrays are passed to TA-Lib without copying
+  talib.execute({
+    name: "ATR",
+    startIdx: 0,
+    endIdx: marketData.close.length - 1,
+    params: {
+      high: Float64Array.from(marketData.high),
+      low: Float64Array.from(marketData.low),
+      close: Float64Array.from(marketData.close),
+      optInTimePeriod: 14,
+    },
+    typed: true,
+  })
+);
+
+// Only the last outputs, reading just the lookback window before them
+console.log(talib.lookback("RSI", { optInTimePeriod: 14 }));
+console.log(
+  talib.execute({
+    name: "RSI",
+    tail: 3,
+    params: { inReal: marketData.close, optInTimePeriod: 14 },
+  })
+);
+
 console.log(
   // Synchronous call
   ADX(marketData.high, marketData.low, marketData.close, {
@@ -61,6 +101,117 @@ console.log(
   })
 );
 
+// Reusable output buffer, aligned with the input indexes
+const outReal = new Float64Array(marketData.close.length);
+
+console.log(
+  SMA_SYNC(marketData.close, { optInTimePeriod: 30, outputs: { outReal } })
+);
+
+// Candlestick patterns, one Int8 row per pattern
+const candles = talib.scanCandles({
+  inputs: marketData,
+  patterns: ["CDLDOJI", "CDLENGULFING", "CDLHAMMER"],
+});
+
+console.log(candles.patterns, candles.matrix.subarray(0, candles.bars));
+
+// Single precision inputs, read by TA-Lib without widening
+console.log(
+  talib.execute({
+    name: "RSI",
+    tail: 3,
+    params: { inReal: new Float32Array(marketData.close), optInTimePeriod: 14 },
+  })
+);
+
+// Prepared function, resolved once and run on every new tick
+const sma30 = talib.prepare("SMA", { optInTimePeriod: 30 });
+
+console.log(sma30.run({ inReal: marketData.close }, { outReal }));
+
+// Columns copied once, then read in place by every call
+const ohlc = talib.frame({
+  high: marketData.high,
+  low: marketData.low,
+  close: marketData.close,
+});
+
+console.log(
+  talib.execute({
+    name: "ATR",
+    startIdx: 0,
+    endIdx: ohlc.length - 1,
+    frame: ohlc,
+  }),
+  talib.execute({
+    name: "SMA",
+    tail: 1,
+    frame: ohlc,
+    params: { inReal: "close", optInTimePeriod: 20 },
+  })
+);
+
+// Five base bars per row, extended as new bars arrive
+const bars5 = talib.resample({ every: 5, columns: ["high", "low", "close"] });
+
+bars5.update(ohlc);
+ohlc.append({ high: 93.5, low: 92.1, close: 93.0 });
+bars5.update(ohlc);
+
+console.log(
+  bars5.complete,
+  talib.execute({
+    name: "ATR",
+    startIdx: 0,
+    endIdx: bars5.frame.length - 1,
+    frame: bars5.frame,
+  })
+);
+
+// Column file, mapped back and read by TA-Lib without copying
+const columnFile = `${os.tmpdir()}/napi-talib-ohlc.bin`;
+
+talib.writeColumns(columnFile, {
+  high: marketData.high,
+  low: marketData.low,
+  close: marketData.close,
+});
+
+const mapped = talib.mapColumns(columnFile);
+
+console.log(
+  talib.execute({
+    name: "ATR",
+    startIdx: 0,
+    endIdx: mapped.close.length - 1,
+    params: { ...mapped, optInTimePeriod: 14 },
+  })
+);
+
+// Streaming indicator, seeded once and updated bar by bar
+const rsi14 = talib.stream(
+  "RSI",
+  { optInTimePeriod: 14 },
+  { inReal: marketData.close }
+);
+
+console.log(rsi14.update(marketData.close[0]));
+console.log(rsi14.replaceLast(marketData.close[1]));
+
+// Stream with its own settings, other calls keep the defaults
+const ema10 = talib.stream(
+  "EMA",
+  { optInTimePeriod: 10 },
+  { inReal: marketData.close },
+  { unstablePeriod: { EMA: 5 }, compatibility: talib.Compatibility.METASTOCK }
+);
+
+console.log(ema10.update(marketData.close[0]));
+
+// Positional call without the param object
+console.log(talib.direct.SMA(marketData.close, 30));
+
 // Asynchronous call
 talib.execute(
   {
@@ -81,6 +232,110 @@ talib.execute(
   }
 );
 
+// Batch call, the shared close array is marshalled once
+talib.executeBatch(
+  [5, 10, 20].map((period) => ({
+    name: "EMA",
+    startIdx: 0,
+    endIdx: marketData.close.length - 1,
+    params: { inReal: marketData.close, optInTimePeriod: period },
+  })),
+  { parallel: true },
+  (error, results) => {
+    if (error) {
+      console.error(error.message);
+    } else {
+      console.log(results);
+    }
+  }
+);
+
+talib.setExecutorOptions({ threads: 4 });
+
+// Same indicator over many series on the native thread pool
+talib.executeUniverse(
+  { name: "RSI", params: { optInTimePeriod: 14 } },
+  [marketData.close, marketData.open, marketData.high, marketData.low].map(
+    (inReal) => ({ inReal })
+  ),
+  (error, results) => {
+    if (error) {
+      console.error(error.message);
+    } else {
+      console.log(results);
+    }
+  }
+);
+
+// Parameter sweep into one row-major matrix
+talib.executeSweep(
+  { name: "BBANDS", params: { inReal: marketData.close } },
+  { optInTimePeriod: [10, 20, 50], optInNbDevUp: [1.5, 2] },
+  (error, result) => {
+    if (error) {
+      console.error(error.message);
+    } else {
+      console.log(result.params, result.results.outRealUpperBand);
+    }
+  }
+);
+
+// Promise call, aborted before it gets a thread
+const controller = new AbortController();
+
+talib
+  .executeSweepAsync(
+    { name: "SMA", params: { inReal: marketData.close } },
+    { optInTimePeriod: [5, 10, 20] },
+    { signal: controller.signal }
+  )
+  .catch((error) => console.log(error.name));
+
+controller.abort();
+
+// Periods outside TA-Lib's ranges are reported, not computed
+for (const period of [0, -1, 1]) {
+  for (const [name, optInput] of [
+    ["MAX", "optInTimePeriod"],
+    ["AROON", "optInTimePeriod"],
+    ["STOCH", "optInFastK_Period"],
+  ]) {
+    try {
+      talib.execute({
+        name,
+        startIdx: 0,
+        endIdx: marketData.close.length - 1,
+        params: {
+          inReal: marketData.close,
+          high: marketData.high,
+          low: marketData.low,
+          close: marketData.close,
+          [optInput]: period,
+        },
+      });
+      console.log(name, period, "computed");
+    } catch (error) {
+      console.log(name, period, error.message);
+    }
+  }
+}
+
+// RSI of an EMA in one native call, the EMA stays in native memory
+console.log(
+  talib.executePipeline({
+    inputs: { close: marketData.close },
+    nodes: [
+      {
+        id: "ema",
+        name: "EMA",
+        inputs: { inReal: "close" },
+        params: { optInTimePeriod: 10 },
+      },
+      { id: "rsi", name: "RSI", inputs: { inReal: "ema" } },
+    ],
+  })
+);
+
 // Parallel computing
 Promise.all([
   SMA(marketData.close, { optInTimePeriod: 5 }),
@@ -88,4 +343,7 @@ Promise.all([
 ]).then(([sma, ema]) => {
   console.log("SMA:", sma);
   console.log("EMA:", ema);
+  console.log("Executor:", talib.getExecutorStats());
+  console.log("Pool:", talib.getPoolStats(), talib.trimPool());
+  console.log("Stats:", talib.stats().functions);
 });
@@ -55,6 +55,18 @@ export enum Compatibility {
   METASTOCK,
 }
 
+/**
+ * Per call TA-Lib settings on top of the ones set by setUnstablePeriod and
+ * setCompatibility. Calls with different settings can run at the same time.
+ */
+export type FuncSettings = {
+  /** e.g. { EMA: 30 } or { [FuncUnstId.EMA]: 30 }, ALL applies before the others */
+  unstablePeriod?: { [funcId in keyof typeof FuncUnstId]?: number } & {
+    [funcId: number]: number;
+  };
+  compatibility?: Compatibility;
+};
+
 export type InputParameterType = "price" | "real" | "integer";
 
 export type InputFlags =
@@ -121,15 +133,284 @@ export type FuncInfo = {
   outputs: OutputParameterInfo[];
 };
 
+export type TypedArray =
+  | Int8Array
+  | Uint8Array
+  | Uint8ClampedArray
+  | Int16Array
+  | Uint16Array
+  | Int32Array
+  | Uint32Array
+  | Float32Array
+  | Float64Array
+  | BigInt64Array;
+
+/**
+ * Float64Array (real inputs) and Int32Array (integer inputs) are zero-copy,
+ * also when they view a SharedArrayBuffer read by several workers.
+ * When every input is a Float32Array, common functions run their TA_S_*
+ * single precision variant on them in place.
+ */
+export type InputArray = number[] | TypedArray;
+
 export type FuncParam = {
   name: string;
-  startIdx: number;
-  endIdx: number;
-  params: { [name: string]: number[] | number };
+  /** With a frame, a string names the column read by an input */
+  params?: { [name: string]: InputArray | number | string };
+  /** Inputs missing from params are read from the frame columns of the same name */
+  frame?: Frame;
+  /** Return results as Float64Array/Int32Array that own the native buffers */
+  typed?: boolean;
+  /** Preallocated outputs, written at the same indexes as the inputs */
+  outputs?: FuncOutputs;
+  /** Add the time spent in each phase of the call to the result */
+  profile?: boolean;
+} & FuncSettings &
+  FuncRange;
+
+export type FuncRange =
+  | { startIdx: number; endIdx: number }
+  | {
+      /** Only the last N outputs, only their lookback window is read */
+      tail: number;
+    };
+
+/**
+ * Only [startIdx, endIdx] is written, so workers can fill disjoint slices of
+ * arrays sharing one SharedArrayBuffer
+ */
+export type FuncOutputs = { [name: string]: Float64Array | Int32Array };
+
+export type BatchOptions = {
+  /** Run the jobs of the batch on multiple threads */
+  parallel?: boolean;
+};
+
+export type AsyncOptions = {
+  /** Drops the call if it has not started, batches stop between jobs */
+  signal?: AbortSignal;
 };
 
-export type FuncResult = {
+export type UniverseSpec = {
+  name: string;
+  /** Defaults to 0 */
+  startIdx?: number;
+  /** Defaults to the last index of each series */
+  endIdx?: number;
+  /** Only the last N outputs of each series, overrides the indexes */
+  tail?: number;
+  /** Optional inputs shared by every series */
+  params?: { [name: string]: number };
+  typed?: boolean;
+} & FuncSettings;
+
+export type SweepSpec = {
+  name: string;
+  /** Inputs and the optional inputs that stay fixed */
+  params?: { [name: string]: InputArray | number | string };
+  frame?: Frame;
+  /** Defaults to 0 */
+  startIdx?: number;
+  /** Defaults to the last index of the inputs */
+  endIdx?: number;
+} & FuncSettings;
+
+/** Values of each swept optional input, combined as a cartesian product */
+export type SweepGrid = { [name: string]: number[] | Float64Array };
+
+export type SweepResult = {
+  rows: number;
+  columns: number;
+  /** First valid index of each row, in input indexes */
+  begIndex: Int32Array;
+  /** Optional inputs of each row, the first grid input changes slowest */
+  params: { [name: string]: number }[];
+  /** Row-major matrices, one row per combination, columns aligned from startIdx */
+  results: { [name: string]: Float64Array | Int32Array };
+};
+
+export type PipelineNode = {
+  /** Defaults to the function name */
+  id?: string;
+  name: string;
+  /**
+   * Wiring of the function inputs, e.g. { inReal: "ema" } or
+   * { close: "bbands.outRealMiddleBand" }. A reference is "node",
+   * "node.output" or the name of a pipeline input, and defaults to the
+   * pipeline input named like the function input.
+   */
+  inputs?: { [name: string]: string };
+  params?: { [name: string]: number };
+};
+
+export type PipelineSpec = {
+  inputs: SeriesInputs | Frame;
+  /** Nodes run in order and can only read the nodes before them */
+  nodes: PipelineNode[];
+  /** Node ids to return, defaults to the nodes no other node reads */
+  outputs?: string[];
+} & FuncSettings;
+
+/** Results of the returned nodes, begIndex is in pipeline input indexes */
+export type PipelineResult = {
+  [id: string]: FuncResult<Float64Array | Int32Array>;
+};
+
+export type CandleScanSpec = {
+  /** open, high, low and close */
+  inputs: SeriesInputs | Frame;
+  /** Pattern Recognition functions, all of them when omitted */
+  patterns?: string[];
+  /** e.g. { optInPenetration }, applied to the patterns that have it */
+  optInputs?: { [name: string]: number };
+} & FuncSettings;
+
+/**
+ * Row i of the matrix holds patterns[i] for every bar: 1 or -1 for a
+ * bullish or bearish hit, 2 or -2 when confirmed, 0 otherwise.
+ */
+export type CandleScanResult = {
+  patterns: string[];
+  bars: number;
+  matrix: Int8Array;
+};
+
+/** Inputs of one series, e.g. { close } or { high, low, close } */
+export type SeriesInputs = { [name: string]: InputArray };
+
+export type OutputArray = number[] | Float64Array | Int32Array;
+
+export type FuncResult<T extends OutputArray = number[]> = {
   begIndex: number;
   nbElement: number;
-  results: { [name: string]: number[] };
+  results: { [name: string]: T };
+  /** Only with 'profile' */
+  timings?: FuncTimings;
+};
+
+/**
+ * Native thunk of one function: its inputs in TA-Lib order with prices
+ * expanded, then its optInputs, startIdx and endIdx. Omitted trailing
+ * arguments take their defaults.
+ */
+export type DirectFunction = (
+  ...args: (InputArray | number | undefined)[]
+) => FuncResult<Float64Array | Int32Array>;
+
+/** Microseconds spent reading the inputs, in TA-Lib, and building the result */
+export type FuncTimings = {
+  parse: number;
+  compute: number;
+  marshal: number;
+};
+
+export interface PreparedFunction {
+  readonly name: string;
+  /** Run over the whole inputs, optionally into preallocated outputs */
+  run(
+    inputs: SeriesInputs | Frame,
+    outputs?: FuncOutputs
+  ): FuncResult<Float64Array | Int32Array>;
+}
+
+/** Columns owned by native memory, read in place by every call */
+export interface Frame {
+  readonly length: number;
+  /** Append one bar, or many with arrays, to every column; returns the new length */
+  append(rows: { [column: string]: number | InputArray }): number;
+}
+
+/** How the base bars of a row combine, NaN values are skipped */
+export type ResampleRule = "first" | "last" | "max" | "min" | "sum";
+
+export type ResampleSpec = {
+  /** A row per this many base bars */
+  every?: number;
+  /** Or a row per non-empty bucket of this width over the timestamp column */
+  interval?: number;
+  /** Timestamp column name, defaults to "timestamp" and holds the bucket start */
+  timestamp?: string;
+  /** Bucket alignment, defaults to 0 */
+  origin?: number;
+  /** Defaults to OHLCV, names alone take first/max/min/last/sum by name */
+  columns?: string[] | { [column: string]: ResampleRule };
+};
+
+export interface Resampler {
+  /** Resampled columns, the last row is rewritten until the next one starts */
+  readonly frame: Frame;
+  /** Number of rows with all their base bars */
+  readonly complete: number;
+  /** Fold new base bars, a frame is read on from where the last update stopped */
+  update(bars: { [column: string]: number | InputArray } | Frame): number;
+}
+
+/** Columns viewing a mapped file, timestamps are kept as BigInt64Array */
+export type MappedColumns = { [column: string]: Float64Array | BigInt64Array };
+
+/** One bar, keyed by input name or price component */
+export type StreamBar = { [name: string]: number };
+
+export type StreamResult = { [name: string]: number };
+
+export interface StreamIndicator {
+  readonly name: string;
+  /** Append a new bar and return the latest outputs */
+  update(bar: number | StreamBar): StreamResult;
+  /** Recompute the last bar, e.g. while it is still forming */
+  replaceLast(bar: number | StreamBar): StreamResult;
+}
+
+export type ExecutorOptions = {
+  /** Number of worker threads, 0 or omitted means one per core */
+  threads?: number;
+  /** Pin each worker thread to a CPU core */
+  affinity?: boolean;
+};
+
+/** Times are in microseconds */
+export type ExecutorStats = {
+  threads: number;
+  queued: number;
+  maxQueued: number;
+  submitted: number;
+  completed: number;
+  waitTime: number;
+  maxWaitTime: number;
+  runTime: number;
+};
+
+/** liveBytes and cachedBytes are gauges, they are not cleared by resetPoolStats */
+export type PoolStats = {
+  allocations: number;
+  hits: number;
+  misses: number;
+  liveBytes: number;
+  cachedBytes: number;
+  trimmedBytes: number;
+};
+
+/** Times are in microseconds, buckets[i] counts the samples up to Stats.buckets[i] */
+export type StatsHistogram = {
+  count: number;
+  sum: number;
+  buckets: number[];
+};
+
+/** queueWait is only recorded by async calls */
+export type FuncStats = {
+  calls: number;
+  elements: number;
+  inputBytes: number;
+  parse: StatsHistogram;
+  compute: StatsHistogram;
+  marshal: StatsHistogram;
+  queueWait: StatsHistogram;
+};
+
+export type Stats = {
+  enabled: boolean;
+  /** Upper bounds of the histogram buckets, the last one is Infinity */
+  buckets: number[];
+  functions: { [name: string]: FuncStats };
 };